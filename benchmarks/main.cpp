@@ -0,0 +1,223 @@
+#include "CoordinateUtils.hpp"
+#include "InputUtils.hpp"
+#include "RangeUtils.hpp"
+#include "Runner.hpp"
+#include "StringUtils.hpp"
+#include "VectorUtils.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Microbenchmarks for every registered solveN and for the hot utilities.
+// The solvers run on synthetic inputs that repeat the shipped dayN/input1.txt 1x, 10x, 100x and 1000x.
+//
+// usage: aoc_benchmarks [--benchmark_filter=<regex>] [any other Google Benchmark flag]
+//  e.g. --benchmark_filter='^day5/'  or  --benchmark_filter='/1$' for the shipped inputs only
+
+namespace {
+    // How a shipped input can be repeated and still be a valid puzzle input
+    enum scaling_e {
+        e_notScalable,      // the input is one connected puzzle (a single map, a single graph, ...)
+        e_lines,            // independent lines, or a grid that may grow downwards
+        e_blocks,           // independent blocks separated by an empty line
+        e_commaList         // one line of comma separated steps
+    };
+
+    struct DayScaling {
+        int day;
+        scaling_e scaling;
+        int maximumScale[2];    // per part; 0 while that part is too slow to benchmark at all
+    };
+
+    // Scales are capped where a solver is quadratic (or worse) in its input.
+    const std::vector<DayScaling> dayScalings = {
+        {1, e_lines, {1000, 1000}},
+        {2, e_lines, {1000, 1000}},
+        {3, e_lines, {10, 10}},
+        {4, e_lines, {1000, 1000}},
+        {5, e_notScalable, {1, 1}},
+        {6, e_notScalable, {1, 1}},
+        {7, e_notScalable, {1, 1}},     // repeated hands break the ranking
+        {8, e_notScalable, {1, 1}},
+        {9, e_lines, {1000, 1000}},
+        {10, e_notScalable, {1, 1}},
+        {11, e_lines, {1000, 1000}},
+        {12, e_lines, {1000, 1000}},
+        {13, e_blocks, {1000, 1000}},
+        {14, e_lines, {1000, 10}},    // stacked platforms loop with the lcm of their own loop lengths
+        {15, e_commaList, {1000, 1000}},
+        {16, e_lines, {100, 1}},
+        {17, e_lines, {1, 1}},
+    };
+
+    const std::vector<int> scales = {1, 10, 100, 1000};
+
+    std::string scaleInput(std::string_view input, scaling_e scaling, int scale) {
+        while (!input.empty() && input.back() == '\n') {
+            input.remove_suffix(1);
+        }
+
+        const std::string_view separator = (scaling == e_blocks)? "\n\n" : (scaling == e_commaList)? "," : "\n";
+
+        std::string ret;
+        ret.reserve((input.size() + separator.size()) * scale);
+        for (int i = 0; i < scale; i++) {
+            if (i != 0) {
+                ret += separator;
+            }
+            ret += input;
+        }
+        ret += '\n';
+        return ret;
+    }
+
+    void benchmarkSolve(benchmark::State & state, const Runner::solveFunction & solve, std::filesystem::path path, scaling_e scaling, int scale) {
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            state.SkipWithError("cannot open input");
+            return;
+        }
+        const std::string input = scaleInput(file.getContents(), scaling, scale);
+
+        // The solvers print plenty of progress on std::cout, which is also where the report goes.
+        auto coutBuffer = std::cout.rdbuf(nullptr);
+        for (auto _ : state) {
+            InputUtils::LineReader reader(input);
+            benchmark::DoNotOptimize(solve(reader));
+        }
+        std::cout.rdbuf(coutBuffer);
+        state.SetBytesProcessed(state.iterations() * input.size());
+    }
+
+    void registerSolveBenchmarks() {
+        for (const auto & puzzle : Runner::getPuzzles()) {
+            for (const auto & dayScaling : dayScalings) {
+                if (dayScaling.day != puzzle.day) {
+                    continue;
+                }
+                const auto path = std::filesystem::path(AOC_SOURCE_DIR) / ("day" + std::to_string(puzzle.day)) / "input1.txt";
+                for (int part = 0; part < 2; part++) {
+                    for (const auto & scale : scales) {
+                        if (scale > dayScaling.maximumScale[part]) {
+                            continue;
+                        }
+                        const std::string name = "day" + std::to_string(puzzle.day) + "/solve" + std::to_string(part + 1) + "/" + std::to_string(scale);
+                        benchmark::RegisterBenchmark(name.c_str(), benchmarkSolve, puzzle.solve[part], path, dayScaling.scaling, scale)
+                            ->Unit(benchmark::kMillisecond);
+                    }
+                }
+            }
+        }
+    }
+
+    void benchmarkSplit(benchmark::State & state) {
+        std::string input;
+        for (int i = 0; i < state.range(0); i++) {
+            input += "Game " + std::to_string(i) + ": 3 blue, 4 red; 1 red, 2 green, 6 blue; 2 green";
+            input += '\n';
+        }
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(StringUtils::split(input, "; "));
+        }
+        state.SetBytesProcessed(state.iterations() * input.size());
+    }
+    BENCHMARK(benchmarkSplit)->Name("StringUtils::split")->RangeMultiplier(10)->Range(10, 100000);
+
+    void benchmarkShatter(benchmark::State & state) {
+        std::mt19937_64 generator(5);
+        std::uniform_int_distribution<long long int> distribution(0, 1LL << 40);
+        std::vector<RangeUtils::Range<long long int>> ranges;
+        for (int i = 0; i < state.range(0); i++) {
+            const auto start = distribution(generator);
+            ranges.emplace_back(start, start + distribution(generator) / 64);
+        }
+
+        for (auto _ : state) {
+            for (size_t i = 1; i < ranges.size(); i++) {
+                benchmark::DoNotOptimize(RangeUtils::shatter(ranges[i - 1], ranges[i]));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * (ranges.size() - 1));
+    }
+    BENCHMARK(benchmarkShatter)->Name("RangeUtils::shatter")->RangeMultiplier(10)->Range(10, 100000);
+
+    void benchmarkApplyOffsets(benchmark::State & state) {
+        std::mt19937_64 generator(6);
+        std::uniform_int_distribution<long long int> distribution(0, 1LL << 40);
+        std::vector<RangeUtils::Range<long long int>> ranges;
+        std::vector<RangeUtils::Breakpoint<long long int>> breakpoints;
+        for (int i = 0; i < state.range(0); i++) {
+            const auto start = distribution(generator);
+            ranges.emplace_back(start, start + distribution(generator) / 64);
+            breakpoints.push_back({distribution(generator), distribution(generator) - (1LL << 39)});
+        }
+        std::sort(breakpoints.begin(), breakpoints.end(), [](const auto & lhs, const auto & rhs) {
+            return lhs.start < rhs.start;
+        });
+        const RangeUtils::RangeSet<long long int> rangeSet(ranges);
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(RangeUtils::applyOffsets(rangeSet, breakpoints));
+        }
+        state.SetItemsProcessed(state.iterations() * (rangeSet.size() + breakpoints.size()));
+    }
+    BENCHMARK(benchmarkApplyOffsets)->Name("RangeUtils::applyOffsets")->RangeMultiplier(10)->Range(10, 100000);
+
+    void benchmarkIntersection(benchmark::State & state) {
+        std::mt19937 generator(4);
+        std::uniform_int_distribution<int> distribution(0, 100);
+        std::vector<int> winningNumbers(state.range(0));
+        std::vector<int> playingNumbers(state.range(0) * 2);
+        for (auto & number : winningNumbers) {
+            number = distribution(generator);
+        }
+        for (auto & number : playingNumbers) {
+            number = distribution(generator);
+        }
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(VectorUtils::intersection(winningNumbers, playingNumbers));
+        }
+        state.SetItemsProcessed(state.iterations() * (winningNumbers.size() + playingNumbers.size()));
+    }
+    BENCHMARK(benchmarkIntersection)->Name("VectorUtils::intersection")->RangeMultiplier(10)->Range(10, 100000);
+
+    void benchmarkIsAdjacent(benchmark::State & state) {
+        std::mt19937 generator(3);
+        std::uniform_int_distribution<int> distribution(0, 140);
+        std::vector<ICoordinates> coordinates(state.range(0));
+        for (auto & coordinate : coordinates) {
+            coordinate = {distribution(generator), distribution(generator)};
+        }
+
+        for (auto _ : state) {
+            size_t adjacentCount = 0;
+            for (size_t i = 1; i < coordinates.size(); i++) {
+                adjacentCount += CoordinateUtils::isAdjacent(coordinates[i - 1], coordinates[i]);
+            }
+            benchmark::DoNotOptimize(adjacentCount);
+        }
+        state.SetItemsProcessed(state.iterations() * (coordinates.size() - 1));
+    }
+    BENCHMARK(benchmarkIsAdjacent)->Name("CoordinateUtils::isAdjacent")->RangeMultiplier(10)->Range(10, 100000);
+};
+
+int main(int argc, char ** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    registerSolveBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -1,10 +1,15 @@
+#include "CoutUtils.hpp"
+#include "InputUtils.hpp"
+#include "Runner.hpp"
+
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+namespace day1 {
+
 // Something is wrong with global snow production, and you've been selected to take a look.
 // The Elves have even given you a map; on it, they've used stars to mark the top fifty locations that are likely to be having problems.
 
@@ -36,13 +41,15 @@
 
 // Consider your entire calibration document. What is the sum of all of the calibration values?
 
-// std::string givenTestData = "\
-// 1abc2\n\
-// pqr3stu8vwx\n\
-// a1b2c3d4e5f\n\
-// treb7uchet";
+const std::string givenTestData_problem1 = "\
+1abc2\n\
+pqr3stu8vwx\n\
+a1b2c3d4e5f\n\
+treb7uchet\n";
 
-std::string givenTestData = "\
+constexpr int expectedSolution_problem1 = 142;
+
+const std::string givenTestData_problem2 = "\
 two1nine\n\
 eightwothree\n\
 abcone2threexyz\n\
@@ -51,9 +58,11 @@ xtwone3four\n\
 zoneight234\n\
 7pqrstsixteen\n";
 
-std::vector<std::pair<int, int>> getPairs(std::vector<std::string> inputLines) {
+constexpr int expectedSolution_problem2 = 281;
+
+std::vector<std::pair<int, int>> getPairs(const std::vector<std::string_view> & inputLines) {
     std::vector<std::pair<int, int>> ret;
-    for(const std::string & line : inputLines) {
+    for(std::string_view line : inputLines) {
         auto iFirst = line.find_first_of("0123456789");
         int first = line[iFirst] - '0';
         auto iLast = line.find_last_of("0123456789");
@@ -66,19 +75,21 @@ std::vector<std::pair<int, int>> getPairs(std::vector<std::string> inputLines) {
 }
 
 template<typename T>
-void solve1(T & stream) {
+int solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     //get pairs
     auto pairs = getPairs(lines);
 
+    Runner::markParsed();
+
     // print pairs
     for (auto [first, last] : pairs) {
-        std::cout << "first:[" << first << "], last:[" << last << "]" << std::endl;
+        LOG(debug, "first:[" << first << "], last:[" << last << "]");
     }
 
     // sum
@@ -90,10 +101,11 @@ void solve1(T & stream) {
     }
 
     std::cout << sum << std::endl;
+    return sum;
 }
 
 
-std::pair<int, int> findValueOfFirstStringDigit(const std::string & str) {
+std::pair<int, int> findValueOfFirstStringDigit(std::string_view str) {
     const std::vector<std::string> numbers = {
         "zero",
         "one",
@@ -128,7 +140,7 @@ std::pair<int, int> findValueOfFirstStringDigit(const std::string & str) {
     return ret;
 }
 
-std::pair<int, int> findValueOfLastStringDigit(const std::string & str) {
+std::pair<int, int> findValueOfLastStringDigit(std::string_view str) {
     const std::vector<std::string> numbers = {
         "zero",
         "one",
@@ -148,7 +160,7 @@ std::pair<int, int> findValueOfLastStringDigit(const std::string & str) {
         auto index = str.rfind(numberString);
         if (index != std::string::npos) {
             indices.push_back({index, i});
-            std::cout << i << std::endl;
+            LOG(debug, i);
         }
     }
 
@@ -165,17 +177,17 @@ std::pair<int, int> findValueOfLastStringDigit(const std::string & str) {
     return ret;
 }
 
-std::vector<std::pair<int, int>> getPairsWithString(const std::vector<std::string> & inputLines) {
+std::vector<std::pair<int, int>> getPairsWithString(const std::vector<std::string_view> & inputLines) {
     std::vector<std::pair<int, int>> ret;
-    for(const std::string & line : inputLines) {
-        std::cout << line << std::endl;
+    for(std::string_view line : inputLines) {
+        LOG(debug, line);
 
         auto iFirstDigit = line.find_first_of("0123456789");
         auto firstString = findValueOfFirstStringDigit(line);
 
         int first;
-        std::cout << "iFirstDigit: " << iFirstDigit << std::endl;
-        std::cout << "firstString.first: " << firstString.first << std::endl;
+        LOG(debug, "iFirstDigit: " << iFirstDigit);
+        LOG(debug, "firstString.first: " << firstString.first);
         if ((iFirstDigit != std::string::npos && iFirstDigit < firstString.first) || firstString.first == std::string::npos){
             first = line[iFirstDigit] - '0';
         } else {
@@ -186,38 +198,40 @@ std::vector<std::pair<int, int>> getPairsWithString(const std::vector<std::strin
         auto iLastDigit = line.find_last_of("0123456789");
         auto lastString = findValueOfLastStringDigit(line);
 
-        std::cout << "iLastDigit: " << iLastDigit << std::endl;
-        std::cout << "lastString.first: " << lastString.first << std::endl;
+        LOG(debug, "iLastDigit: " << iLastDigit);
+        LOG(debug, "lastString.first: " << lastString.first);
         int last;
         if ((iLastDigit != std::string::npos && iLastDigit > lastString.first) || lastString.first == std::string::npos){
             last = line[iLastDigit] - '0';
         } else {
             last = lastString.second;
         }
-        std::cout << "first: " << first << std::endl;
-        std::cout << "last: " << last << std::endl;
+        LOG(debug, "first: " << first);
+        LOG(debug, "last: " << last);
 
         ret.push_back({first, last});
-        std::cout << std::endl;
+        LOG(debug, "");
     }
 
     return ret;
 }
 
 template<typename T>
-void solve2(T & stream) {
+int solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     //get pairs
     auto pairs = getPairsWithString(lines);
 
+    Runner::markParsed();
+
     // print pairs
     for (auto [first, last] : pairs) {
-        std::cout << "first:[" << first << "], last:[" << last << "]" << std::endl;
+        LOG(debug, "first:[" << first << "], last:[" << last << "]");
     }
 
     // sum
@@ -229,6 +243,7 @@ void solve2(T & stream) {
     }
 
     std::cout << sum << std::endl;
+    return sum;
 }
 
 // Your calculation isn't quite right. It looks like some of the digits are actually spelled out with letters:
@@ -244,34 +259,43 @@ void solve2(T & stream) {
 // zoneight234
 // 7pqrstsixteen
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(1, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
 
+}; // namespace day1
 
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day1;
+
     if (argc == 1) {
-        // std::stringstream strStream(givenTestData);
-        // solve1(strStream);
-        std::stringstream strStream(givenTestData);
-        solve2(strStream);
+        // InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        // solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        solve2(testData_problem2);
     } else if (argc == 2 || argc == 3) {
         std::string url(argv[1]);
         std::cout << url << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (fileStream.is_open()) {
+        InputUtils::MappedFile file(path);
+        if (file.is_open()) {
             std::cout << "IsOpen" << std::endl;
         } else {
             std::cout << "Is NOT Open" << std::endl;
         }
+        InputUtils::LineReader fileInput(file);
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            solve1(fileStream);
+            solve1(fileInput);
         } else if(argc == 3 && argv[2][0] == 'B') {
-            solve2(fileStream);
+            solve2(fileInput);
             std::cout << "solve2" << std::endl;
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
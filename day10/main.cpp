@@ -1,21 +1,27 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
+#include <cstdlib>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 
+namespace day10 {
+
 
 using puzzleValueType = long long int;
 
@@ -141,185 +147,181 @@ SJ.L7\n\
 LJ...\n";
 constexpr puzzleValueType expectedSolution_problem1 = 8;
 
-const CoordinateUtils::ICoordinates up{0,-1};
-const CoordinateUtils::ICoordinates down{0,1};
-const CoordinateUtils::ICoordinates west{-1,0};
-const CoordinateUtils::ICoordinates east{1,0};
+// The connections of a tile, one bit per direction, clockwise, so the opposite direction is two bits further.
+enum direction_e : uint8_t {
+    e_up = 1,
+    e_east = 2,
+    e_down = 4,
+    e_west = 8
+};
+using connectionMask = uint8_t;
+
+constexpr std::array<connectionMask, 256> CONNECTIONS = []() {
+    std::array<connectionMask, 256> connections{};  //ground, and S until it is known, connect nowhere
+    connections['|'] = e_up | e_down;
+    connections['-'] = e_east | e_west;
+    connections['L'] = e_up | e_east;
+    connections['J'] = e_up | e_west;
+    connections['7'] = e_down | e_west;
+    connections['F'] = e_down | e_east;
+    return connections;
+}();
+
+constexpr connectionMask opposite(connectionMask direction) {
+    return ((direction << 2) | (direction >> 2)) & 0xF;
+}
+
+// indexed by the bit number of a direction
+const std::array<CoordinateUtils::ICoordinates, 4> offsets = {
+    CoordinateUtils::ICoordinates{0,-1},
+    CoordinateUtils::ICoordinates{1,0},
+    CoordinateUtils::ICoordinates{0,1},
+    CoordinateUtils::ICoordinates{-1,0}
+};
+
+inline const CoordinateUtils::ICoordinates & getOffset(connectionMask direction) {
+    return offsets[std::countr_zero(direction)];
+}
 
 class Pipe {
 private:
-    char c;
+    connectionMask connections = 0;
+
 public:
-    Pipe(const char & c) : c(c)
-    {
+    Pipe() {}
+    explicit Pipe(connectionMask connections) : connections(connections) {}
 
+    connectionMask getConnections() const {
+        return connections;
     }
 
-    char getCharacter() const {
-        return c;
+    // Either way along the pipe.
+    connectionMask getFirstDirection() const {
+        assert(std::popcount(connections) == 2);
+        return connections & -connections;
     }
 
-    bool hasUp() const {
-        return hasUpConnection(c);
+    // Whether something that moves in direction can enter this pipe.
+    bool connectsFrom(connectionMask direction) const {
+        return (connections & opposite(direction)) != 0;
     }
 
-    bool hasEast() const {
-        return hasEastConnection(c);
+    // The way out for something that moved in, in direction.
+    connectionMask getNextDirection(connectionMask direction) const {
+        assert(connections & opposite(direction));
+        return connections & ~opposite(direction);
     }
+};
 
-    const CoordinateUtils::ICoordinates & getFirstCoordinates() const {
-        if (hasDownConnection(c)) {
-            return down;
-        } else if(hasEastConnection(c)) {
-            return east;
-        } else if(hasUpConnection(c)) {
-            return up;
+// The map read straight from the input text without copying it: tile (x, y) is contents[y * stride + x].
+// Tiles outside the map read as ground, and S reads as the pipe that fits its neighbours.
+class PipeMap {
+private:
+    std::string_view contents;
+    std::ptrdiff_t width = 0;
+    std::ptrdiff_t height = 0;
+    std::ptrdiff_t stride = 0;      //width + the newline
+    CoordinateUtils::ICoordinates startingPoint{0, 0};
+    connectionMask start = 0;
+
+    connectionMask getTileConnections(const CoordinateUtils::ICoordinates & coordinates) const {
+        if (coordinates.x < 0 || coordinates.y < 0 || coordinates.x >= width || coordinates.y >= height) {
+            return 0;
         }
-        std::cout << "c:[" << c << "]" << std::endl;
-        assert(false);
+        return CONNECTIONS[static_cast<unsigned char>(contents[coordinates.y * stride + coordinates.x])];
     }
 
-    const CoordinateUtils::ICoordinates & getSecondCoordinates() const {
-        if (hasWestConnection(c)) {
-            return west;
-        } else if(hasUpConnection(c)) {
-            return up;
-        } else if(hasEastConnection(c)) {
-            return east;
+public:
+    // Returns false when the lines differ in length, when there is no S to start from, or when S doesn't connect to exactly two neighbours.
+    bool parse(std::string_view input) {
+        contents = input;
+        const size_t firstNewline = contents.find('\n');
+        width = (firstNewline == std::string_view::npos)? contents.size() : firstNewline;
+        stride = width + 1;
+        const std::ptrdiff_t size = contents.size() + ((contents.empty() || contents.back() == '\n')? 0 : 1);  //as if the last line ends in a newline
+        height = size / stride;
+        bool rectangular = (size % stride == 0);
+        for (std::ptrdiff_t y=0; rectangular && y < height; y++) {
+            const std::ptrdiff_t newline = y * stride + width;
+            rectangular = (newline == static_cast<std::ptrdiff_t>(contents.size()) || contents[newline] == '\n');
         }
-        assert(false);
-    }
-
-    const CoordinateUtils::ICoordinates & getUnmatchingCoordinates(const CoordinateUtils::ICoordinates & unmatch) const {
-        // gets the coordinates that don't match 'unmatch'
-        if (hasWestConnection(c) && west != unmatch) {
-            return west;
-        } else if(hasUpConnection(c) && up != unmatch) {
-            return up;
-        } else if(hasEastConnection(c) && east != unmatch) {
-            return east;
-        } else if(hasDownConnection(c) && down != unmatch) {
-            return down;
+        if (!rectangular) {
+            std::cerr << "day10: the lines are not all [" << width << "] tiles wide" << std::endl;
+            return false;
         }
-        assert(false);
-        return down;
-    }
 
-    static bool hasDownConnection(const char & c) {
-        return (c == '|' || c == 'F' || c == '7');
-    }
+        const size_t startIndex = contents.find('S');
+        if (startIndex == std::string_view::npos) {
+            std::cerr << "day10: no starting point S in the input" << std::endl;
+            return false;
+        }
+        startingPoint = CoordinateUtils::ICoordinates(startIndex % stride, startIndex / stride);
 
-    static bool hasUpConnection( const char & c) {
-        return (c == '|' || c == 'J' || c == 'L');
+        start = 0;
+        for (connectionMask direction = e_up; direction <= e_west; direction <<= 1) {
+            if (getTileConnections(startingPoint + getOffset(direction)) & opposite(direction)) {
+                start |= direction;
+            }
+        }
+        LOG(debug, "S connects as:[" << static_cast<int>(start) << "]");
+        if (std::popcount(start) != 2) {
+            std::cerr << "day10: S connects to [" << std::popcount(start) << "] neighbours instead of two" << std::endl;
+            return false;
+        }
+        return true;
     }
 
-    static bool hasWestConnection( const char & c) {
-        return (c == '-' || c == 'J' || c == '7');
+    const CoordinateUtils::ICoordinates & getStartingPoint() const {
+        return startingPoint;
     }
 
-    static bool hasEastConnection( const char & c) {
-        return (c == '-' || c == 'F' || c == 'L');
+    Pipe operator[](const CoordinateUtils::ICoordinates & coordinates) const {
+        if (coordinates == startingPoint) {
+            return Pipe(start);
+        }
+        return Pipe(getTileConnections(coordinates));
     }
-
 };
 
+// Calls visit(from, to) for every move along the loop, ending back on the starting point.
+// Returns false when the pipes run into a tile that doesn't connect back, so there is no loop.
+template<typename F>
+bool walkLoop(const PipeMap & pipes, F visit) {
+    const CoordinateUtils::ICoordinates & startingPoint = pipes.getStartingPoint();
+    CoordinateUtils::ICoordinates coordinates = startingPoint;
+    connectionMask direction = pipes[startingPoint].getFirstDirection();
+    do {
+        const CoordinateUtils::ICoordinates next = coordinates + getOffset(direction);
+        const Pipe pipe = pipes[next];
+        if (!pipe.connectsFrom(direction)) {
+            std::cerr << "day10: the loop breaks off at [" << next.x << "," << next.y << "]" << std::endl;
+            return false;
+        }
+        visit(coordinates, next);
+        coordinates = next;
+        direction = pipe.getNextDirection(direction);
+    } while (coordinates != startingPoint);
+    return true;
+}
 
 template<typename T>
 puzzleValueType solve1(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
-    }
-
-    std::vector<std::vector<char> > map;
-    for (auto & line : lines) {
-        std::vector<char> mapRow;
-        for (auto & c : line) {
-            mapRow.push_back(c);
-        }
-        map.push_back(mapRow);
-    }
-
-    std::vector<std::vector<Pipe> > pipes;
-    CoordinateUtils::ICoordinates startingPoint;
-    int y=0;
-    int x=0;
-    for (auto & line : lines) {
-        std::vector<Pipe> pipesInThisLine;
-        for (auto & c : line) {
-            if (c == 'S') {
-                startingPoint = CoordinateUtils::ICoordinates{x,y};
-                bool up   = (y>0) &&                    Pipe::hasDownConnection(map[y-1][x]);
-                bool down = (y < map.size()-1) &&       Pipe::hasUpConnection(map[y+1][x]);
-                bool west = (x>0) &&                    Pipe::hasEastConnection(map[y][x-1]);
-                bool east = (x < map[0].size()-1) &&    Pipe::hasWestConnection(map[y][x+1]);
-                std::cout << "up: [" << up << "]" << std::endl;
-                std::cout << "down: [" << down << "]" << std::endl;
-                std::cout << "west: [" << west << "]" << std::endl;
-                std::cout << "east: [" << east << "]" << std::endl;
-                int count = 0;
-                if (up) count++;
-                if (down) count++;
-                if (west) count++;
-                if (east) count++;
-                assert(count == 2);
-
-                if (up) {
-                    if (down) {
-                        std::cout << "S, as:[|]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('|'));
-                    } else if(west) {
-                        std::cout << "S, as:[J]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('J'));
-                    } else {// if(east) {
-                        std::cout << "S, as:[L]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('L'));
-                    }
-                } else if (down) {
-                    if(west) {
-                        std::cout << "S, as:[7]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('7'));
-                    } else {// if(east) {
-                        std::cout << "S, as:[F]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('F'));
-                    }
-                } else {
-                        std::cout << "S, as:[-]" << std::endl;
-                    pipesInThisLine.push_back(Pipe('-'));
-                }
-            } else {
-                pipesInThisLine.push_back(Pipe(c));
-            }
-            x++;
-        }
-        pipes.push_back(pipesInThisLine);
-        x=0;
-        y++;
+    // the loop is walked over the input itself, so memory stays the same however big the map is
+    PipeMap pipes;
+    if (!pipes.parse(stream.getContents())) {
+        return -1;
     }
-
-    // count pipes
-    puzzleValueType puzzleValue = 0;
-    std::cout << "startingPoint[" << startingPoint.x << ", " << startingPoint.y << "]" << std::endl;
-    std::cout << "startingPoint[" << startingPoint.x << ", " << startingPoint.y << "]" << std::endl;
-    CoordinateUtils::ICoordinates pathACoordinates = startingPoint + pipes[startingPoint.y][startingPoint.x].getFirstCoordinates();
-    CoordinateUtils::ICoordinates pathBCoordinates = startingPoint + pipes[startingPoint.y][startingPoint.x].getSecondCoordinates();
-    puzzleValue++;
-    CoordinateUtils::ICoordinates previousOffsetA = pipes[startingPoint.y][startingPoint.x].getFirstCoordinates();
-    CoordinateUtils::ICoordinates previousOffsetB = pipes[startingPoint.y][startingPoint.x].getSecondCoordinates();
-    std::cout << "pathACoordinates[" << pathACoordinates.x << ", " << pathACoordinates.y << "]" << std::endl;
-    std::cout << "pathBCoordinates[" << pathBCoordinates.x << ", " << pathBCoordinates.y << "]" << std::endl;
-    while (pathACoordinates != pathBCoordinates) {
-        auto offsetA = pipes[pathACoordinates.y][pathACoordinates.x].getUnmatchingCoordinates(CoordinateUtils::invert(previousOffsetA));
-        auto offsetB = pipes[pathBCoordinates.y][pathBCoordinates.x].getUnmatchingCoordinates(CoordinateUtils::invert(previousOffsetB));
-        previousOffsetA = offsetA;
-        previousOffsetB = offsetB;
-        pathACoordinates = pathACoordinates + offsetA;
-        pathBCoordinates = pathBCoordinates + offsetB;
-        puzzleValue++;
+    Runner::markParsed();
+
+    // the farthest point is halfway around the loop
+    puzzleValueType loopLength = 0;
+    if (!walkLoop(pipes, [&loopLength](const CoordinateUtils::ICoordinates &, const CoordinateUtils::ICoordinates &) {
+        loopLength++;
+    })) {
+        return -1;
     }
 
-    return puzzleValue;
+    return loopLength / 2;
 }
 
 // --- Part Two ---
@@ -459,241 +461,49 @@ L7JLJL-JLJLJL--JLJ.L\n";
 constexpr puzzleValueType expectedSolution_problem2 = 10;
 
 
-void addIfAbleFunc(std::queue<CoordinateUtils::ICoordinates> & coordinatesToProcess,
-                   const std::vector<std::vector<char> > & map2,
-                   const CoordinateUtils::ICoordinates & coordsToTest)
-{
-    // std::cout << "coordsToTest:[" << coordsToTest.x << ", " << coordsToTest.y << "]" << std::endl;
-    if (coordsToTest.x >= 0 && coordsToTest.x < map2[0].size()) {
-        if (coordsToTest.y >= 0 && coordsToTest.y < map2.size()) {
-            coordinatesToProcess.push(coordsToTest);
-        }
-    }
-}
-
 template<typename T>
 puzzleValueType solve2(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
+    // the loop is walked over the input itself, so memory stays the same however big the map is
+    PipeMap pipes;
+    if (!pipes.parse(stream.getContents())) {
+        return -1;
     }
-
-    std::vector<std::vector<char> > map;
-    for (auto & line : lines) {
-        std::vector<char> mapRow;
-        for (auto & c : line) {
-            mapRow.push_back(c);
-        }
-        map.push_back(mapRow);
-    }
-
-    std::vector<std::vector<Pipe> > pipes;
-    CoordinateUtils::ICoordinates startingPoint;
-    int y=0;
-    int x=0;
-    for (auto & line : lines) {
-        std::vector<Pipe> pipesInThisLine;
-        for (auto & c : line) {
-            if (c == 'S') {
-                startingPoint = CoordinateUtils::ICoordinates{x,y};
-                bool up   = (y>0) &&                    Pipe::hasDownConnection(map[y-1][x]);
-                bool down = (y < map.size()-1) &&       Pipe::hasUpConnection(map[y+1][x]);
-                bool west = (x>0) &&                    Pipe::hasEastConnection(map[y][x-1]);
-                bool east = (x < map[0].size()-1) &&    Pipe::hasWestConnection(map[y][x+1]);
-                std::cout << "up: [" << up << "]" << std::endl;
-                std::cout << "down: [" << down << "]" << std::endl;
-                std::cout << "west: [" << west << "]" << std::endl;
-                std::cout << "east: [" << east << "]" << std::endl;
-                int count = 0;
-                if (up) count++;
-                if (down) count++;
-                if (west) count++;
-                if (east) count++;
-                assert(count == 2);
-
-                if (up) {
-                    if (down) {
-                        std::cout << "S, as:[|]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('|'));
-                    } else if(west) {
-                        std::cout << "S, as:[J]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('J'));
-                    } else {// if(east) {
-                        std::cout << "S, as:[L]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('L'));
-                    }
-                } else if (down) {
-                    if(west) {
-                        std::cout << "S, as:[7]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('7'));
-                    } else {// if(east) {
-                        std::cout << "S, as:[F]" << std::endl;
-                        pipesInThisLine.push_back(Pipe('F'));
-                    }
-                } else {
-                        std::cout << "S, as:[-]" << std::endl;
-                    pipesInThisLine.push_back(Pipe('-'));
-                }
-            } else {
-                pipesInThisLine.push_back(Pipe(c));
-            }
-            x++;
-        }
-        pipes.push_back(pipesInThisLine);
-        x=0;
-        y++;
-    }
-
-
-
-    //fill with blanks and grounds
-    const char ground = '.';
-    const char filler = ' ';
-    std::vector<std::vector<char> > map2;
-    std::vector<char> bottomLine;
-    bottomLine.push_back(filler);    //+1 for x
-    for (size_t x=0; x < pipes[0].size(); x++) {
-        bottomLine.push_back(filler);
-        bottomLine.push_back(filler);//*2 for x
+    Runner::markParsed();
+
+    // Walk the loop once. The shoelace formula gives its area through the centres of its tiles,
+    //  and Pick's theorem (area = inside + boundary/2 - 1) turns that into the whole tiles inside.
+    puzzleValueType doubleArea = 0;
+    puzzleValueType loopLength = 0;
+    if (!walkLoop(pipes, [&](const CoordinateUtils::ICoordinates & from, const CoordinateUtils::ICoordinates & to) {
+        doubleArea += static_cast<puzzleValueType>(from.x) * to.y - static_cast<puzzleValueType>(to.x) * from.y;
+        loopLength++;
+    })) {
+        return -1;
     }
-    map2.push_back(bottomLine); // +1 for y
-
-    for (size_t y=0; y < pipes.size(); y++) {
-        std::vector<char> line1;
-        line1.push_back(filler); //+1 for x
-        for (size_t x=0; x < pipes[0].size(); x++) {
-            line1.push_back(ground);
-            line1.push_back(filler); //*2 for x
-        }
-        map2.push_back(line1);
 
-        std::vector<char> line2;    //*2 for y
-        line2.push_back(filler); //+1 for x
-        for (size_t x=0; x < pipes[0].size(); x++) {
-            line2.push_back(filler);
-            line2.push_back(filler); //*2 for x
-        }
-        map2.push_back(line2);
-        assert(line1.size() == line2.size());
-    }
-
-    // Fill in connected pipes; and count them
-    // x*2+1
-    // y*2+1
-    // ....
-    // .F7.
-    // .SJ.
-    // ....
-    puzzleValueType pipeCount = 0;
-    const Pipe & startingPipe = pipes[startingPoint.y][startingPoint.x];
-    map2[startingPoint.y*2+1][startingPoint.x*2+1] = startingPipe.getCharacter();   //mark as impassible pipe
-    pipeCount++;
-    if (startingPipe.hasUp()) {
-        map2[startingPoint.y*2+1-1][startingPoint.x*2+1] = 'y';   //mark as impassible pipe
-    }
-    if (startingPipe.hasEast()) {
-        map2[startingPoint.y*2+1][startingPoint.x*2+1+1] = 'x';   //mark as impassible pipe
-    }
-    CoordinateUtils::ICoordinates pathACoordinates = startingPoint + startingPipe.getFirstCoordinates();
-    {
-        const Pipe & pipeA = pipes[pathACoordinates.y][pathACoordinates.x];
-        if (pipeA.hasUp()) {
-            map2[pathACoordinates.y*2+1-1][pathACoordinates.x*2+1] = 'y';   //mark as impassible pipe
-        }
-        if (pipeA.hasEast()) {
-            map2[pathACoordinates.y*2+1][pathACoordinates.x*2+1+1] = 'x';   //mark as impassible pipe
-        }
-        map2[pathACoordinates.y*2+1][pathACoordinates.x*2+1] = pipeA.getCharacter();   //mark as impassible pipe
-        pipeCount++;
-    }
-    CoordinateUtils::ICoordinates pathBCoordinates = startingPoint + startingPipe.getSecondCoordinates();
-    {
-        const Pipe & pipeB = pipes[pathBCoordinates.y][pathBCoordinates.x];
-        if (pipeB.hasUp()) {
-            map2[pathBCoordinates.y*2+1-1][pathBCoordinates.x*2+1] = 'y';   //mark as impassible pipe
-        }
-        if (pipeB.hasEast()) {
-            map2[pathBCoordinates.y*2+1][pathBCoordinates.x*2+1+1] = 'x';   //mark as impassible pipe
-        }
-        map2[pathBCoordinates.y*2+1][pathBCoordinates.x*2+1] = pipeB.getCharacter();   //mark as impassible pipe
-        // pipeCount++;     //this one is redundant; will be counted in the main loop; so this line is commented, otherwise it will be counted twice
-    }
-    CoordinateUtils::ICoordinates previousOffsetA = pipes[startingPoint.y][startingPoint.x].getFirstCoordinates();
-    CoordinateUtils::ICoordinates previousOffsetB = pipes[startingPoint.y][startingPoint.x].getSecondCoordinates();
-    while (pathACoordinates != pathBCoordinates) {
-        const Pipe & pipeA = pipes[pathACoordinates.y][pathACoordinates.x];
-        auto offsetA = pipeA.getUnmatchingCoordinates(CoordinateUtils::invert(previousOffsetA));
-        previousOffsetA = offsetA;
-        pathACoordinates = pathACoordinates + offsetA;
-        {
-            const Pipe & newPipeA = pipes[pathACoordinates.y][pathACoordinates.x];
-            map2[pathACoordinates.y*2+1][pathACoordinates.x*2+1] = newPipeA.getCharacter();   //mark as impassible pipe
-            pipeCount++;
-            if (newPipeA.hasUp()) {
-                map2[pathACoordinates.y*2+1-1][pathACoordinates.x*2+1] = 'y';   //mark as impassible pipe
-            }
-            if (newPipeA.hasEast()) {
-                map2[pathACoordinates.y*2+1][pathACoordinates.x*2+1+1] = 'x';   //mark as impassible pipe
-            }
-        }
-    }
-
-    // for (auto & row : map2) {
-    //     for (auto & c : row) {
-    //         std::cout << c;
-    //     }
-    //     std::cout << std::endl;
-    // }
-
-    // crawl through map, count all grounds OUTSIDE loop
-    std::queue<CoordinateUtils::ICoordinates> coordinatesToProcess;
-    coordinatesToProcess.push(CoordinateUtils::ICoordinates{0,0});
-    puzzleValueType groundsOutsideLoop = 0;
-    while (!coordinatesToProcess.empty()) {
-        auto coords = coordinatesToProcess.front();
-        coordinatesToProcess.pop();
-        char c = map2[coords.y][coords.x];
-        // std::cout << "processing:[" << coords.x << ", " << coords.y << "]:[" << c << "]" << std::endl;
-        map2[coords.y][coords.x] = ';';     //processed; don't do again
-        if (c == ground) {
-            groundsOutsideLoop++;
-            // std::cout << "groundsOutsideLoop:[" << groundsOutsideLoop << "]" << std::endl;
-        }
-        if ((c == filler) || (c == ground)) {
-            auto upwards = coords + up;
-            addIfAbleFunc(coordinatesToProcess, map2, upwards);
-            auto downwards = coords + down;
-            addIfAbleFunc(coordinatesToProcess, map2, downwards);
-            auto westwards = coords + west;
-            addIfAbleFunc(coordinatesToProcess, map2, westwards);
-            auto eastwards = coords + east;
-            addIfAbleFunc(coordinatesToProcess, map2, eastwards);
-        }
-    }
-    // std::cout << std::endl;
-    // std::cout << std::endl;
-
-    // for (auto & row : map2) {
-    //     for (auto & c : row) {
-    //         std::cout << c;
-    //     }
-    //     std::cout << std::endl;
-    // }
-
-    puzzleValueType totalSpaces = map.size() * map[0].size();
-    puzzleValueType puzzleValue = totalSpaces - groundsOutsideLoop - pipeCount;
+    puzzleValueType puzzleValue = (std::abs(doubleArea) - loopLength) / 2 + 1;
+    LOG(debug, "loop length:[" << loopLength << "] area:[" << doubleArea / 2.0 << "]");
 
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(10, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
+
+}; // namespace day10
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day10;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -711,21 +521,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
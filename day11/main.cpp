@@ -1,20 +1,24 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "Grid.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
-#include <set>
+
+namespace day11 {
 
 
 using puzzleValueType = long long int;
@@ -143,123 +147,71 @@ constexpr puzzleValueType expectedSolution_problem1 = 374;
 
 constexpr char GALAXY = '#';
 
-class Galaxy {
+// Galaxies per row and per column; rows and columns without any expand.
+class Universe {
 private:
-    int x;
-    int y;
-public:
-    Galaxy(const int & x, const int & y) : x(x), y(y) {
-        // std::cout << "Galaxy:[" << x << ", " << y << "]" << std::endl;
-    }
-
-    int getX() const {
-        return x;
-    }
-
-    int getY() const {
-        return y;
-    }
-};
-
-template<typename T>
-puzzleValueType solve1(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
-    }
-
-    // Convert lines to 2d array
-    std::vector<std::vector<char> > map;
-    for (const auto & line : lines) {
-        std::vector<char> lineVector;
-        for (const auto & c : line) {
-            lineVector.push_back(c);
+    std::vector<puzzleValueType> galaxiesPerRow;
+    std::vector<puzzleValueType> galaxiesPerColumn;
+
+    // The sum of the distances between every pair of galaxies along one axis.
+    // The galaxies are already sorted along it by their line, so every galaxy is
+    //  'coordinate' away from each of the 'seen' galaxies before it, minus the sum of their coordinates.
+    static puzzleValueType sumOfDistances(const std::vector<puzzleValueType> & galaxiesPerLine, puzzleValueType expansionMultiplier) {
+        puzzleValueType sum = 0;
+        puzzleValueType coordinate = 0;
+        puzzleValueType seen = 0;
+        puzzleValueType coordinatesSeen = 0;
+        for (const auto & galaxies : galaxiesPerLine) {
+            sum += galaxies * (coordinate * seen - coordinatesSeen);
+            seen += galaxies;
+            coordinatesSeen += galaxies * coordinate;
+            coordinate += (galaxies == 0)? expansionMultiplier : 1;
         }
-        map.push_back(lineVector);
+        return sum;
     }
 
-    // Identify columns to double
-    std::set<int> columnsToDouble;
-    for (unsigned int x=0; x < map[0].size(); x++) {
-        bool hasGalaxy = false;
-        for (unsigned int y=0; y < map.size(); y++) {
-            if (map[y][x] == GALAXY) {
-                hasGalaxy = true;
-                break;
-            }
-        }
-        if (!hasGalaxy) {
-            columnsToDouble.insert(x);
+public:
+    // Lines may differ in length, the missing end of a shorter line is empty space.
+    Universe(const std::vector<std::string_view> & lines) :
+        galaxiesPerRow(lines.size(), 0)
+    {
+        size_t width = 0;
+        for (const auto & line : lines) {
+            width = std::max(width, line.size());
         }
-    }
-
-    // Identify rows to double
-    std::set<int> rowsToDouble;
-    for (unsigned int y=0; y < map.size(); y++) {
-        bool hasGalaxy = false;
-        for (unsigned int x=0; x < map[0].size(); x++) {
-            if (map[y][x] == GALAXY) {
-                hasGalaxy = true;
-                break;
+        galaxiesPerColumn.assign(width, 0);
+        for (size_t y=0; y < lines.size(); y++) {
+            for (size_t x = lines[y].find(GALAXY); x != std::string_view::npos; x = lines[y].find(GALAXY, x + 1)) {
+                galaxiesPerRow[y]++;
+                galaxiesPerColumn[x]++;
             }
         }
-        if (!hasGalaxy) {
-            rowsToDouble.insert(y);
-        }
     }
 
-    std::vector<std::vector<char> > expandedMap;
-    // Double rows and columns
-    for (unsigned int y=0; y < map.size(); y++) {
-        std::vector<char> line;
-        for (unsigned int x=0; x < map[0].size(); x++) {
-            line.push_back(map[y][x]);
-            if (columnsToDouble.contains(x)) {
-                line.push_back(map[y][x]);
-            }
-        }
-        expandedMap.push_back(line);
-        if (rowsToDouble.contains(y)) {
-            expandedMap.push_back(line);
-        }
+    // Every empty row or column counts as expansionMultiplier of them.
+    puzzleValueType sumOfDistances(puzzleValueType expansionMultiplier) const {
+        return sumOfDistances(galaxiesPerRow, expansionMultiplier) + sumOfDistances(galaxiesPerColumn, expansionMultiplier);
     }
+};
 
-    // Make sure we got something shapely.
-    for (unsigned int y=0; y < expandedMap.size(); y++) {
-        assert(expandedMap[0].size() == expandedMap[y].size());
+// Both parts only differ in how much the empty rows and columns expand.
+template<typename T>
+puzzleValueType solveForExpansion(T & stream, puzzleValueType expansionMultiplier) {
+    // convert to lines
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
+        lines.push_back(line);
     }
 
-    // // Print it to make sure
-    // for (unsigned int y=0; y < expandedMap.size(); y++) {
-    //     for (unsigned int x=0; x < expandedMap[0].size(); x++) {
-    //         std::cout << expandedMap[y][x];
-    //     }
-    //     std::cout << std::endl;
-    // }
-
-    // Find all galaxies
-    std::vector<Galaxy> galaxies;
-    for (unsigned int y=0; y < expandedMap.size(); y++) {
-        for (unsigned int x=0; x < expandedMap[0].size(); x++) {
-            if (expandedMap[y][x] == GALAXY) {
-                galaxies.emplace_back(x, y);
-            }
-        }
-    }
+    const Universe universe(lines);
+    Runner::markParsed();
 
-    // Compute distances
-    puzzleValueType puzzleValue = 0;
-    for (unsigned int iA=0; iA < galaxies.size(); iA++) {
-        const Galaxy & galaxyA = galaxies[iA];
-        for (unsigned int iB=iA+1; iB < galaxies.size(); iB++) {
-            const Galaxy & galaxyB = galaxies[iB];
-            puzzleValue += std::abs(galaxyA.getX() - galaxyB.getX());
-            puzzleValue += std::abs(galaxyA.getY() - galaxyB.getY());
-        }
-    }
+    return universe.sumOfDistances(expansionMultiplier);
+}
 
-    return puzzleValue;
+template<typename T>
+puzzleValueType solve1(T & stream) {
+    return solveForExpansion(stream, 2);
 }
 
 
@@ -282,106 +234,35 @@ puzzleValueType solve1(T & stream) {
 
 const std::string & givenTestData_problem2 = givenTestData_problem1;
 
-// constexpr puzzleValueType expectedSolution_problem2 = 374;     // if 'expansionMultiplier' is 2
-// constexpr puzzleValueType expectedSolution_problem2 = 1030;     // if 'expansionMultiplier' is 10
-// constexpr puzzleValueType expectedSolution_problem2 = 8410;     // if 'expansionMultiplier' is 100
 constexpr puzzleValueType expectedSolution_problem2 = 82000210;     // if 'expansionMultiplier' is 1000000
 
-// constexpr int expansionMultiplier = 2;
-// constexpr int expansionMultiplier = 10;
-// constexpr int expansionMultiplier = 100;
 constexpr int expansionMultiplier = 1000000;
 
+// The example for the other expansions mentioned above: {expansionMultiplier, expected solution}
+const std::vector<std::pair<puzzleValueType, puzzleValueType>> expectedSolutions_expansions = {{2, 374}, {10, 1030}, {100, 8410}};
+
 template<typename T>
 puzzleValueType solve2(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
-    }
-
-    // Convert lines to 2d array
-    std::vector<std::vector<char> > map;
-    for (const auto & line : lines) {
-        std::vector<char> lineVector;
-        for (const auto & c : line) {
-            lineVector.push_back(c);
-        }
-        map.push_back(lineVector);
-    }
-
-    // Identify columns to double
-    std::vector<int> multiplierAxisX;
-    int multiplierCountX = 0;
-    for (unsigned int x=0; x < map[0].size(); x++) {
-        bool hasGalaxy = false;
-        for (unsigned int y=0; y < map.size(); y++) {
-            if (map[y][x] == GALAXY) {
-                hasGalaxy = true;
-                break;
-            }
-        }
-        if (!hasGalaxy) {
-            multiplierCountX++;
-        }
-        multiplierAxisX.push_back(multiplierCountX);
-    }
-
-    std::cout << CoutUtils::convertToString("multiplierAxisX", multiplierAxisX) << std::endl;
-
-    // Identify rows to double
-    std::vector<int> multiplierAxisY;
-    int multiplierCountY = 0;
-    for (unsigned int y=0; y < map.size(); y++) {
-        bool hasGalaxy = false;
-        for (unsigned int x=0; x < map[0].size(); x++) {
-            if (map[y][x] == GALAXY) {
-                hasGalaxy = true;
-                break;
-            }
-        }
-        multiplierAxisY.push_back(multiplierCountY);
-        if (!hasGalaxy) {
-            multiplierCountY++;
-        }
-    }
-    std::cout << CoutUtils::convertToString("multiplierAxisY", multiplierAxisY) << std::endl;
-
-    // Find all galaxies
-    std::vector<Galaxy> galaxies;
-    for (unsigned int y=0; y < map.size(); y++) {
-        for (unsigned int x=0; x < map[0].size(); x++) {
-            if (map[y][x] == GALAXY) {
-                // std::cout << "Creating Galaxy[" << x << ", " << y << "]" << std::endl;
-                galaxies.emplace_back(
-                    x + multiplierAxisX[x] * (expansionMultiplier-1),
-                    y + multiplierAxisY[y] * (expansionMultiplier-1)
-                );
-            }
-        }
-    }
+    return solveForExpansion(stream, expansionMultiplier);
+}
 
-    // Compute distances
-    puzzleValueType puzzleValue = 0;
-    for (unsigned int iA=0; iA < galaxies.size(); iA++) {
-        const Galaxy & galaxyA = galaxies[iA];
-        for (unsigned int iB=iA+1; iB < galaxies.size(); iB++) {
-            const Galaxy & galaxyB = galaxies[iB];
-            puzzleValue += std::abs(galaxyA.getX() - galaxyB.getX());
-            puzzleValue += std::abs(galaxyA.getY() - galaxyB.getY());
-        }
-    }
+#ifdef AOC_RUNNER
+const Runner::Registration registration(11, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
 
-    return puzzleValue;
-}
+}; // namespace day11
 
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day11;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -394,26 +275,37 @@ int main(int argc, char ** argv) {
         } else {
             std::cout << "Puzzle B <MISMATCH> :[" << solve2_solution << "]" << std::endl;
         }
+
+        for (const auto & [multiplier, expectedSolution] : expectedSolutions_expansions) {
+            InputUtils::LineReader testData_expansion(givenTestData_problem2);
+            const auto solution = solveForExpansion(testData_expansion, multiplier);
+            if (solution == expectedSolution) {
+                std::cout << "Expansion x" << multiplier << " <Success!> :[" << solution << "]" << std::endl;
+            } else {
+                std::cout << "Expansion x" << multiplier << " <MISMATCH> :[" << solution << "]" << std::endl;
+            }
+        }
     } else if (argc == 2 || argc == 3) {
         std::string url(argv[1]);
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
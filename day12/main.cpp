@@ -1,21 +1,27 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
+#include "ParallelUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
 #include <cassert>
 #include <cctype>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
+#include <limits>
 #include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <set>
 
+namespace day12 {
+
 
 using puzzleValueType = long long int;
 
@@ -146,19 +152,30 @@ constexpr char UNKNOWN = '?';
 constexpr char BROKEN = '#';
 constexpr char WORKING = '.';
 
+// Number of arrangements, which remembers when it stopped fitting instead of wrapping around.
+struct ArrangementCount {
+    NumberUtils::uint128Type value = 0;
+    bool overflow = false;
+
+    ArrangementCount & operator+=(const ArrangementCount & rhs) {
+        overflow = overflow || rhs.overflow || __builtin_add_overflow(value, rhs.value, &value);
+        return *this;
+    }
+};
+
 class SpringRow {
 private:
     std::vector<int> sequences;
     std::string originalRow;
 
 public:
-    SpringRow(const std::string & line, const int complexityMultiplier = 1) {
+    SpringRow(std::string_view line, const unsigned int unfoldFactor = 1) {
         auto sections = StringUtils::split(line, " ");
         // sequences
-        auto sequenceStrings = StringUtils::split(sections[1], ",");
-        for (unsigned int i=0; i < complexityMultiplier; i++) {
-            for (const auto & sequenceString : sequenceStrings) {
-                int sequenceLength = std::stoi(sequenceString);
+        std::vector<int> sequenceLengths;
+        NumberUtils::parseNumbers(sections[1], sequenceLengths);
+        for (unsigned int i=0; i < unfoldFactor; i++) {
+            for (const auto & sequenceLength : sequenceLengths) {
                 if (sequenceLength > 0) {
                     sequences.push_back(sequenceLength);
                 }
@@ -166,7 +183,7 @@ public:
         }
         // original row
         originalRow = "";
-        for (unsigned int i=0; i < complexityMultiplier; i++) {
+        for (unsigned int i=0; i < unfoldFactor; i++) {
             if (i > 0) {
                 originalRow += "?";
             }
@@ -174,77 +191,59 @@ public:
         }
 
         //print to confirm
-        std::cout << "originalRow:[" << originalRow << "]" << std::endl;
-        std::cout << CoutUtils::convertToString("sequences", sequences) << std::endl;
-    }
-
-    puzzleValueType countSolutions() const {
-        puzzleValueType ret = 0;
-        ret = recursiveSolutionSearch(originalRow, 0, 0, calculateMinimalSequenceLength());
-        return ret;
+        LOG(trace, "originalRow:[" << originalRow << "]");
+        LOG(trace, CoutUtils::convertToString("sequences", sequences));
     }
 
-private:
-    int calculateMinimalSequenceLength() const {
-        int ret = 0;
-        for (unsigned int i=0; i < sequences.size(); i++) {
-            ret += sequences[i];
+    // Counts the arrangements with a table of (position in the row, sequence index):
+    //  arrangements[sequenceIndex][position] is the number of ways sequences[sequenceIndex..] fit in originalRow[position..].
+    // Only two of its rows are ever needed, so this is O(row length * number of sequences) time in O(row length) memory.
+    // Heavily unfolded rows have more arrangements than any integer holds, so the count is 128 bits wide and flags when even that overflows.
+    ArrangementCount countSolutions() const {
+        const size_t rowLength = originalRow.size();
+
+        // workingBefore[i]: the number of WORKING springs in originalRow[0, i), to tell in O(1) whether a sequence fits somewhere.
+        std::vector<int> workingBefore(rowLength + 1, 0);
+        for (size_t i=0; i < rowLength; i++) {
+            workingBefore[i+1] = workingBefore[i] + (originalRow[i] == WORKING);
         }
-        assert(!sequences.empty());
-        ret += sequences.size()-1;  //for the holes in between the sequences
-        return ret;
-    }
 
-    puzzleValueType recursiveSolutionSearch(std::string row, int placementIndex, int sequenceIndex, int minimumSequenceLength) const {
-        puzzleValueType ret = 0;
-        
-        if (sequenceIndex >= sequences.size()) {
-            if (validateSolution(row, sequences)) {
-                return 1;
-            } else {
-                return 0;
-            }
+        // No sequences left: only a row without BROKEN springs remaining fits.
+        std::vector<NumberUtils::uint128Type> nextSequence(rowLength + 2, 0);
+        nextSequence[rowLength] = 1;
+        nextSequence[rowLength + 1] = 1;
+        for (size_t position = rowLength; position-- > 0;) {
+            nextSequence[position] = originalRow[position] == BROKEN ? 0 : nextSequence[position + 1];
         }
 
-        int springsLeftToParse = row.size() - (placementIndex + minimumSequenceLength) + 1;     //not sure about the +1 ...
-
-        if (springsLeftToParse < 1) {
-            //doesn't fit anymore
-            return 0;
-        }
-
-        int currentSequenceLength = sequences[sequenceIndex];
-        
-        for (unsigned int i=0; i < springsLeftToParse; i++) {
-
-            bool placeable = true;
-            for (unsigned int i2=0; i2 < currentSequenceLength; i2++) {
-                const auto & spring = row[placementIndex+i+i2];
-                if ((spring != BROKEN) && (spring != UNKNOWN)) {
-                    //i.e. the spring is WORKING
-                    placeable = false;
-                    break;
-                }
-            }
-
-            if (placeable) {
-                std::string rowCopy = row;
-                for (unsigned int i2=0; i2 < currentSequenceLength; i2++) {
-                    rowCopy[placementIndex+i+i2] = BROKEN;
+        std::vector<NumberUtils::uint128Type> currentSequence(rowLength + 2, 0);
+        bool overflow = false;
+        for (size_t sequenceIndex = sequences.size(); sequenceIndex-- > 0;) {
+            const size_t sequenceLength = sequences[sequenceIndex];
+            currentSequence[rowLength] = 0;
+            currentSequence[rowLength + 1] = 0;
+            for (size_t position = rowLength; position-- > 0;) {
+                NumberUtils::uint128Type arrangements = 0;
+                // The spring at 'position' is WORKING: the sequence starts further on.
+                if (originalRow[position] != BROKEN) {
+                    arrangements = currentSequence[position + 1];
                 }
-                int newMinimumSequenceLength = minimumSequenceLength-currentSequenceLength;
-                assert(newMinimumSequenceLength!=1);
-                if (newMinimumSequenceLength > 1) {
-                    newMinimumSequenceLength--;
+                // The sequence starts at 'position': it needs room without WORKING springs, followed by the end of the row or a spring that may be WORKING.
+                const size_t sequenceEnd = position + sequenceLength;
+                if (originalRow[position] != WORKING && sequenceEnd <= rowLength
+                    && workingBefore[sequenceEnd] == workingBefore[position]
+                    && (sequenceEnd == rowLength || originalRow[sequenceEnd] != BROKEN))
+                {
+                    overflow |= __builtin_add_overflow(arrangements, nextSequence[sequenceEnd + 1], &arrangements);
                 }
-                ret += recursiveSolutionSearch(rowCopy, placementIndex+i+currentSequenceLength+1, sequenceIndex+1, newMinimumSequenceLength);
+                currentSequence[position] = arrangements;
             }
+            std::swap(currentSequence, nextSequence);
         }
 
-        return ret;
+        return {nextSequence[0], overflow};
     }
 
-public:
     static bool validateSolution(const std::string & row, const std::vector<int> & sequences) {
         int sequenceIndex = 0;
         for (unsigned int i=0; i < row.size(); i++) {
@@ -273,19 +272,21 @@ public:
     }
 };
 
+// Sum of the arrangements of every row, each unfolded 'unfoldFactor' times; -1 when that does not fit in puzzleValueType.
 template<typename T>
-puzzleValueType solve1(T & stream) {
+puzzleValueType solveUnfolded(T & stream, const unsigned int unfoldFactor) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // Convert lines to spring rows
-    std::vector<SpringRow> springRows;
-    for (const auto & line : lines) {
-        springRows.emplace_back(line);
-    }
+    const std::vector<SpringRow> springRows = ParallelUtils::parallelTransform(lines.size(), [&lines, unfoldFactor](size_t i) {
+        return SpringRow(lines[i], unfoldFactor);
+    });
+
+    Runner::markParsed();
 
     // SpringRow::validateSolution function validation.
     // std::cout << "1st: " << SpringRow::validateSolution("#.#.###", {1,1,3}) << std::endl;   //1
@@ -296,61 +297,55 @@ puzzleValueType solve1(T & stream) {
     // std::cout << "6nd: " << SpringRow::validateSolution(".#.#.###.#", {1,1,3}) << std::endl; //0
     // std::cout << "7nd: " << SpringRow::validateSolution(".#.#.###.#", {1,1,3,1}) << std::endl; //1
 
-    // Count solutions
-    puzzleValueType puzzleValue = 0;
-    for (const auto & springRow : springRows) {
-        puzzleValue += springRow.countSolutions();
+    // Count solutions; unfolded rows are the expensive ones, so they are handed out in smaller chunks.
+    const ArrangementCount arrangements = ParallelUtils::parallelReduce(springRows.size(), ArrangementCount(), [&springRows](size_t i) {
+        return springRows[i].countSolutions();
+    }, (unfoldFactor > 1)? 16 : ParallelUtils::DEFAULT_GRAIN);
+    LOG(debug, "[" << springRows.size() << "] rows - overflow:[" << arrangements.overflow << "]");
+
+    if (arrangements.overflow || arrangements.value > static_cast<NumberUtils::uint128Type>(std::numeric_limits<puzzleValueType>::max())) {
+        std::cerr << "day12: the number of arrangements does not fit, unfolded x" << unfoldFactor << std::endl;
+        return -1;
     }
+    return static_cast<puzzleValueType>(arrangements.value);
+}
 
-    return puzzleValue;
+template<typename T>
+puzzleValueType solve1(T & stream) {
+    return solveUnfolded(stream, 1);
 }
 
 const std::string & givenTestData_problem2 = givenTestData_problem1;
 
 constexpr puzzleValueType expectedSolution_problem2 = 525152;
 
-template<typename T>
-puzzleValueType solve2(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
-    }
+constexpr unsigned int UNFOLD_FACTOR = 5;    //condition records list was folded
 
-    // Convert lines to spring rows
-    std::vector<SpringRow> springRows;
-    for (const auto & line : lines) {
-        springRows.emplace_back(line, 5);   //5: condition records list was folded
-    }
+// x20 no longer fits in puzzleValueType.
+const std::vector<std::pair<unsigned int, puzzleValueType>> expectedSolutions_unfolded = {{10, 384978277676}, {15, 291946876854029552}, {20, -1}};
 
-    // SpringRow::validateSolution function validation.
-    // std::cout << "1st: " << SpringRow::validateSolution("#.#.###", {1,1,3}) << std::endl;   //1
-    // std::cout << "2nd: " << SpringRow::validateSolution("##.#.###", {1,1,3}) << std::endl;  //0
-    // std::cout << "3nd: " << SpringRow::validateSolution(".#.#.###", {1,1,3}) << std::endl;  //1
-    // std::cout << "4nd: " << SpringRow::validateSolution(".#.#.##.#", {1,1,3}) << std::endl; //0
-    // std::cout << "5nd: " << SpringRow::validateSolution(".#.###.#", {1,1,3}) << std::endl; //0
-    // std::cout << "6nd: " << SpringRow::validateSolution(".#.#.###.#", {1,1,3}) << std::endl; //0
-    // std::cout << "7nd: " << SpringRow::validateSolution(".#.#.###.#", {1,1,3,1}) << std::endl; //1
+template<typename T>
+puzzleValueType solve2(T & stream) {
+    return solveUnfolded(stream, UNFOLD_FACTOR);
+}
 
-    // Count solutions
-    puzzleValueType puzzleValue = 0;
-    int counter = 0;
-    for (const auto & springRow : springRows) {
-        std::cout << "calculating [" << counter << "] out of [" << springRows.size() << "] - current number of arrangements:[" << puzzleValue << "]" << std::endl;
-        puzzleValue += springRow.countSolutions();
-        counter++;
-    }
+#ifdef AOC_RUNNER
+const Runner::Registration registration(12, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
 
-    return puzzleValue;
-}
+}; // namespace day12
 
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day12;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -363,26 +358,37 @@ int main(int argc, char ** argv) {
         } else {
             std::cout << "Puzzle B <MISMATCH> :[" << solve2_solution << "]" << std::endl;
         }
+
+        for (const auto & [unfoldFactor, expectedSolution] : expectedSolutions_unfolded) {
+            InputUtils::LineReader testData_unfolded(givenTestData_problem2);
+            const auto solution = solveUnfolded(testData_unfolded, unfoldFactor);
+            if (solution == expectedSolution) {
+                std::cout << "Unfolded x" << unfoldFactor << " <Success!> :[" << solution << "]" << std::endl;
+            } else {
+                std::cout << "Unfolded x" << unfoldFactor << " <MISMATCH> :[" << solution << "]" << std::endl;
+            }
+        }
     } else if (argc == 2 || argc == 3) {
         std::string url(argv[1]);
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
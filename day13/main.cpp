@@ -1,20 +1,25 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "Grid.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <set>
+
+namespace day13 {
 
 
 using puzzleValueType = long long int;
@@ -135,247 +140,189 @@ const std::string givenTestData_problem1 = "\
 
 constexpr puzzleValueType expectedSolution_problem1 = 405;
 
-class Pattern {
+// Lines of a pattern as bitmasks, bit set for rock, wordsPerLine 64 bit words each.
+// Every pattern in the puzzle fits in a single word, so comparing two lines is usually a single XOR.
+class BitLines {
 private:
-    std::vector<std::vector<char> > map;
-    std::vector<std::vector<bool> > xorMapX;
-    std::vector<std::vector<bool> > xorMapY;
+    std::vector<uint64_t> words;
+    size_t wordsPerLine = 1;
+
 public:
-    Pattern(const std::vector<std::vector<char>> & map)
-        : map(map)
-    {
-        for (unsigned int y=0; y < map.size(); y++) {
-            std::vector<bool> xorLine;
-            for (unsigned int x=1; x < map[0].size(); x++) {
-                bool difference = map[y][x-1] != map[y][x];
-                xorLine.push_back(difference);
-                if (difference) {
-                    std::cout << "x";
-                } else {
-                    std::cout << ".";
-                }
-            }
-            xorMapX.push_back(xorLine);
-            std::cout << std::endl;
-        }
-        std::cout << std::endl;
-
-        for (unsigned int y=1; y < map.size(); y++) {
-            std::vector<bool> xorLine;
-            for (unsigned int x=0; x < map[0].size(); x++) {
-                bool difference = map[y-1][x] != map[y][x];
-                xorLine.push_back(difference);
-                if (difference) {
-                    std::cout << "x";
-                } else {
-                    std::cout << ".";
-                }
-            }
-            xorMapY.push_back(xorLine);
-            std::cout << std::endl;
+    // Drops all lines and makes room for lines of length bits.
+    void reset(size_t length) {
+        words.clear();
+        wordsPerLine = std::max<size_t>(1, (length + 63) / 64);
+    }
+
+    void addLine() {
+        words.resize(words.size() + wordsPerLine, 0);
+    }
+
+    // Makes every line one word longer, keeping its bits.
+    // The lines move up in place from the last one down, so this only allocates when the vector outgrows its capacity.
+    void widen() {
+        const size_t lineCount = size();
+        words.resize(lineCount * (wordsPerLine + 1));
+        for (size_t line = lineCount; line-- > 0;) {
+            std::copy_backward(words.begin() + line * wordsPerLine, words.begin() + (line + 1) * wordsPerLine,
+                words.begin() + line * (wordsPerLine + 1) + wordsPerLine);
+            words[line * (wordsPerLine + 1) + wordsPerLine] = 0;
         }
-        std::cout << std::endl;
+        wordsPerLine++;
     }
 
-    bool findVerticalMirror(puzzleValueType & out, unsigned int numberOfSmudges = 0) const {    //which mirrors horizontally
-        std::cout << "vertical" << std::endl;
+    size_t capacity() const {
+        return wordsPerLine * 64;
+    }
 
-        std::set<long int> possibleMirrorIndices;
+    void set(size_t line, size_t bit) {
+        words[line * wordsPerLine + bit / 64] |= uint64_t(1) << (bit % 64);
+    }
 
-        for (long int x=0; x < xorMapX[0].size(); x++) {
-            unsigned int differenceCount = 0;
-            bool noDifference = true;
-            for (long int y=0; y < xorMapX.size(); y++) {
-                if (xorMapX[y][x]) {
-                    //difference found
-                    differenceCount++;
-                    if (differenceCount > numberOfSmudges) {
-                        noDifference = false;
-                        break;
-                    }
-                }
-            }
-            if (noDifference) {
-                possibleMirrorIndices.insert(x);
-            }
-        }
+    bool get(size_t line, size_t bit) const {
+        return (words[line * wordsPerLine + bit / 64] >> (bit % 64)) & 1;
+    }
+
+    size_t size() const {
+        return words.size() / wordsPerLine;
+    }
 
-        if (possibleMirrorIndices.empty()) {
-            return false;
+    unsigned int difference(size_t lhs, size_t rhs) const {
+        if (wordsPerLine == 1) {
+            return std::popcount(words[lhs] ^ words[rhs]);
+        }
+        unsigned int ret = 0;
+        for (size_t word=0; word < wordsPerLine; word++) {
+            ret += std::popcount(words[lhs * wordsPerLine + word] ^ words[rhs * wordsPerLine + word]);
         }
+        return ret;
+    }
+};
+
+// A pattern as one bitmask per row and one per column.
+class Pattern {
+private:
+    BitLines rows;
+    BitLines columns;
+    size_t width = 0;
 
-        // Find mirror
-        bool solutionFound = false;
-        for (auto & possibleMirrorIndex : possibleMirrorIndices) {
-            PRINT(possibleMirrorIndex);
-            bool isMirror = true;
+    // The mirror after lines[index] where the lines on both sides differ in exactly numberOfSmudges places.
+    static bool findMirror(const BitLines & lines, puzzleValueType & out, unsigned int numberOfSmudges) {
+        for (size_t index = 0; index + 1 < lines.size(); index++) {
             unsigned int differenceCount = 0;
-            for (long int x=0; x < map[0].size(); x++) {
-                if (possibleMirrorIndex - x < 0) {
-                    break;
-                }
-                if (possibleMirrorIndex + x + 1 >= map[0].size()) {
-                    break;
-                }
-                for (long int y=0; y < map.size(); y++) {
-                    const auto & leftSide = map[y][possibleMirrorIndex - x];
-                    const auto & rightSide = map[y][possibleMirrorIndex + 1 + x];
-                    bool difference = leftSide != rightSide;
-                    if (difference) {
-                        differenceCount++;
-                        if (differenceCount > numberOfSmudges) {
-                            isMirror = false;
-                            break;
-                        }
-                    }
-                }
-                if (!isMirror) {
+            for (size_t before = index + 1, after = index + 1; before > 0 && after < lines.size(); after++) {
+                differenceCount += lines.difference(--before, after);
+                if (differenceCount > numberOfSmudges) {
                     break;
                 }
             }
-            if (isMirror && differenceCount == numberOfSmudges) {
-                assert(!solutionFound);
-                solutionFound = true;
-                out = possibleMirrorIndex;
-                break;
+            if (differenceCount == numberOfSmudges) {
+                out = index;
+                return true;
             }
         }
-
-        return solutionFound;
+        return false;
     }
 
-    bool findHorizontalMirror(puzzleValueType & out, unsigned int numberOfSmudges = 0) const {    //which mirrors vertically
-        std::cout << "horizontal" << std::endl;
-        std::set<long int> possibleMirrorIndices;
-
-        for (long int y=0; y < xorMapY.size(); y++) {
-            unsigned int differenceCount = 0;
-            bool noDifference = true;
-            for (long int x=0; x < xorMapY[0].size(); x++) {
-                if (xorMapY[y][x]) {
-                    //difference found
-                    differenceCount++;
-                    if (differenceCount > numberOfSmudges) {
-                        noDifference = false;
-                        break;
-                    }
-                }
-            }
-            if (noDifference) {
-                possibleMirrorIndices.insert(y);
+public:
+    // Appends the next row; the pattern keeps its memory when it's cleared, so it can be reused for the next one.
+    void addRow(std::string_view line) {
+        if (rows.size() == 0) {
+            width = line.size();
+            rows.reset(width);
+            columns.reset(0);
+            for (size_t x=0; x < width; x++) {
+                columns.addLine();
             }
         }
-
-        if (possibleMirrorIndices.empty()) {
-            return false;
+        assert(line.size() == width);
+        const size_t y = rows.size();
+        rows.addLine();
+        if (y == columns.capacity()) {
+            columns.widen();
         }
-
-        // Find mirror
-        bool solutionFound = false;
-        for (auto & possibleMirrorIndex : possibleMirrorIndices) {
-            std::cout << std::endl;
-            PRINT(possibleMirrorIndex);
-            bool isMirror = true;
-            unsigned int differenceCount = 0;
-            for (long int y=0; y < map.size(); y++) {
-                if (possibleMirrorIndex - y < 0) {
-                    break;
-                }
-                if (possibleMirrorIndex + y + 1 >= map.size()) {
-                    break;
-                }
-                for (long int x=0; x < map[0].size(); x++) {
-                    const auto & upSide = map[possibleMirrorIndex - y][x];
-                    const auto & downSide = map[possibleMirrorIndex + 1 + y][x];
-                    bool difference = upSide != downSide;
-                    if (difference) {
-                        differenceCount++;
-                        if (differenceCount > numberOfSmudges) {
-                            isMirror = false;
-                            break;
-                        }
-                    }
-                }
-                if (!isMirror) {
-                    break;
-                }
-            }
-            if (isMirror && differenceCount == numberOfSmudges) {
-                assert(!solutionFound);
-                solutionFound = true;
-                out = possibleMirrorIndex;
-                break;
-            } else {
-                std::cout << "is no mirror" << std::endl;
-                PRINT(isMirror);
-                PRINT(differenceCount);
+        for (size_t x=0; x < line.size() && x < width; x++) {
+            if (line[x] == '#') {
+                rows.set(y, x);
+                columns.set(x, y);
             }
         }
-        return solutionFound;
     }
 
-    void print() const {
-        CoutUtils::print2d(map);
-        std::cout << std::endl;
-        CoutUtils::print2d(xorMapX);
-        std::cout << std::endl;
-        CoutUtils::print2d(xorMapY);
+    void clear() {
+        rows.reset(0);
+        columns.reset(0);
+        width = 0;
     }
-};
 
-template<typename T>
-puzzleValueType solve1(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
+    bool empty() const {
+        return rows.size() == 0;
     }
 
-    std::vector<Pattern> patterns;
-    std::vector<std::vector<char> > map;
-    for (const auto & line : lines) {
-        if (line.empty()) {
-            if (!map.empty()) {
-                patterns.emplace_back(map);
-                map.clear();
-            }
-        } else {
-            std::vector<char> lineAsVector(line.begin(), line.end());
-            map.push_back(lineAsVector);
-        }
+    bool findVerticalMirror(puzzleValueType & out, unsigned int numberOfSmudges = 0) const {    //which mirrors horizontally
+        return findMirror(columns, out, numberOfSmudges);
     }
 
-    if (!map.empty()) {
-        patterns.emplace_back(map);
-        map.clear();
+    bool findHorizontalMirror(puzzleValueType & out, unsigned int numberOfSmudges = 0) const {    //which mirrors vertically
+        return findMirror(rows, out, numberOfSmudges);
     }
 
-    // Find mirror positions
-    puzzleValueType puzzleValue = 0;
-    constexpr puzzleValueType horizontalMultiplier = 100;
-    for (const auto & pattern : patterns) {
-        std::cout << "-" << std::endl;
-        pattern.print();
+    // The columns left of its vertical mirror, or 100 times the rows above its horizontal mirror.
+    puzzleValueType summarize(unsigned int numberOfSmudges) const {
+        constexpr puzzleValueType horizontalMultiplier = 100;
         puzzleValueType index = 0;
-        int mirrorCount = 0;
-        if (pattern.findVerticalMirror(index)) {
-            mirrorCount++;
-            puzzleValue += (index + 1);
+        if (findVerticalMirror(index, numberOfSmudges)) {
+            assert(!findHorizontalMirror(index, numberOfSmudges));
+            return index + 1;
         }
+        [[maybe_unused]] const bool found = findHorizontalMirror(index, numberOfSmudges);
+        assert(found);
+        return (index + 1) * horizontalMultiplier;
+    }
 
-        if (pattern.findHorizontalMirror(index)) {
-            mirrorCount++;
-            puzzleValue += (index + 1) * horizontalMultiplier;
+    void print() const {
+        for (size_t y=0; y < rows.size(); y++) {
+            for (size_t x=0; x < width; x++) {
+                LOG_PART(debug, (rows.get(y, x)? '#' : '.'));
+            }
+            LOG(debug, "");
         }
-        if (mirrorCount != 1) {
-            std::cout << "mirrorCount:" << mirrorCount << std::endl;
+    }
+};
+
+// Reads one pattern at a time into the same scratch pattern and scores it right away,
+//  so memory stays the same however many patterns the input holds.
+template<typename T>
+puzzleValueType summarizePatterns(T & stream, unsigned int numberOfSmudges) {
+    puzzleValueType puzzleValue = 0;
+    Pattern pattern;
+    auto summarize = [&]() {
+        LOG(debug, "-");
+        pattern.print();
+        puzzleValue += pattern.summarize(numberOfSmudges);
+        pattern.clear();
+    };
+
+    for (std::string_view line; InputUtils::getline(stream, line);) {
+        if (!line.empty()) {
+            pattern.addRow(line);
+        } else if (!pattern.empty()) {
+            summarize();
         }
-        assert(mirrorCount == 1);
+    }
+    if (!pattern.empty()) {
+        summarize();
     }
 
+    // parsing and solving are interleaved, so there is no parse time to mark
     return puzzleValue;
 }
 
+template<typename T>
+puzzleValueType solve1(T & stream) {
+    return summarizePatterns(stream, 0);
+}
+
 // --- Part Two ---
 // You resume walking through the valley of mirrors and - SMACK! - run directly into one.
 // Hopefully nobody was watching, because that must have been pretty embarrassing.
@@ -463,66 +410,28 @@ constexpr puzzleValueType expectedSolution_problem2 = 400;
 
 template<typename T>
 puzzleValueType solve2(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
-    }
-
-    std::vector<Pattern> patterns;
-    std::vector<std::vector<char> > map;
-    for (const auto & line : lines) {
-        if (line.empty()) {
-            if (!map.empty()) {
-                patterns.emplace_back(map);
-                map.clear();
-            }
-        } else {
-            std::vector<char> lineAsVector(line.begin(), line.end());
-            map.push_back(lineAsVector);
-        }
-    }
-
-    if (!map.empty()) {
-        patterns.emplace_back(map);
-        map.clear();
-    }
-
-    // Find mirror positions
-    puzzleValueType puzzleValue = 0;
-    constexpr puzzleValueType horizontalMultiplier = 100;
-    for (const auto & pattern : patterns) {
-        std::cout << "-" << std::endl;
-        pattern.print();
-        puzzleValueType index = 0;
-        int mirrorCount = 0;
-        if (pattern.findVerticalMirror(index, 1)) {
-            mirrorCount++;
-            puzzleValue += (index + 1);
-        }
+    return summarizePatterns(stream, 1);
+}
 
-        if (pattern.findHorizontalMirror(index, 1)) {
-            mirrorCount++;
-            puzzleValue += (index + 1) * horizontalMultiplier;
-        }
-        if (mirrorCount != 1) {
-            std::cout << "mirrorCount:" << mirrorCount << std::endl;
-        }
-        assert(mirrorCount == 1);
-    }
+#ifdef AOC_RUNNER
+const Runner::Registration registration(13, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
 
-    return puzzleValue;
-}
+}; // namespace day13
 
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day13;
+
     if (argc == 1) {
         std::cout << " --- PUZZLE A --- " << std::endl;
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
         std::cout << " --- PUZZLE B --- " << std::endl;
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -540,21 +449,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
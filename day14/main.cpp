@@ -1,20 +1,29 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "Grid.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
+#include <unordered_map>
+#include <utility>
+
+namespace day14 {
 
 
 using puzzleValueType = long long int;
@@ -109,194 +118,200 @@ constexpr char ROLLING_ROCK = 'O';
 constexpr char CUBE_ROCK = '#';
 constexpr char EMPTY = '.';
 
-void copyMapExceptRollingRocks(const std::vector<std::vector<char> > & initialMap, std::vector<std::vector<char> > & mapCopy) {
-    assert(!initialMap.empty());
-    // Copy the map as if there were no rolling rocks on it.
-    for (const auto & initialMapLine : initialMap) {
-        std::vector<char> mapCopyLine;
-        for (auto & c : initialMapLine) {
-            if (c == CUBE_ROCK) {
-                mapCopyLine.push_back(CUBE_ROCK);
-            } else {
-                mapCopyLine.push_back(EMPTY);  // we ignore the rolling rocks for now. re-add them later
-            }
+// The platform as bitboards: one bit per cell, each row in 'wordsPerRow' words (cell x is bit x%64 of word x/64).
+// North/south tilts move whole words of rocks one row at a time, east/west tilts count the rocks
+//  between two cube rocks and pack them against one side.
+class Platform {
+private:
+    using word = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+
+    size_t width;
+    size_t height;
+    size_t wordsPerRow;
+    std::vector<word> cubeRocks;
+    std::vector<word> rollingRocks;
+    std::vector<std::vector<std::pair<size_t, size_t>>> segments;    // per row, the [begin, end) runs between cube rocks
+    std::vector<word> moving;                                          // scratch row for the north/south tilts
+
+    static word bitsBelow(size_t bit) {
+        return bit >= WORD_BITS ? ~word(0) : (word(1) << bit) - 1;
+    }
+
+    word * getRow(std::vector<word> & bitboard, size_t y) {
+        return bitboard.data() + y * wordsPerRow;
+    }
+
+    const word * getRow(const std::vector<word> & bitboard, size_t y) const {
+        return bitboard.data() + y * wordsPerRow;
+    }
+
+    // Calls function(wordOfRow, mask) for every word holding some of the bits [begin, end).
+    template<typename F>
+    static void forEachWord(word * row, size_t begin, size_t end, F function) {
+        for (size_t i = begin / WORD_BITS; i * WORD_BITS < end; i++) {
+            const size_t low = std::max(begin, i * WORD_BITS) - i * WORD_BITS;
+            const size_t high = std::min(end, (i + 1) * WORD_BITS) - i * WORD_BITS;
+            function(row[i], bitsBelow(high) & ~bitsBelow(low));
         }
-        mapCopy.push_back(mapCopyLine);
     }
-}
 
-void moveRollingRocksNorthwards(const std::vector<std::vector<char> > & initialMap, std::vector<std::vector<char> > & _movedMap) {
-    assert(!initialMap.empty());
-    
-    std::vector<std::vector<char> > movedMap;
-    copyMapExceptRollingRocks(initialMap, movedMap);
-    assert(movedMap.size() == initialMap.size());
-    assert(movedMap[0].size() == initialMap[0].size());
-
-    // Copy the rolling rocks as if they moved upwards
-    for (size_t x=0; x < initialMap[0].size(); x++) {
-        unsigned int rockCount = 0;
-        for (size_t y=0; y < initialMap.size(); y++) {
-            // calculate read coordinates
-            TCoordinates<size_t> rC{x, initialMap.size()-y-1};  //-1 to convert to indices.     [rC]: Read Coordinates
-            const char & readCharacter = initialMap[rC.y][rC.x];
-            if (readCharacter == ROLLING_ROCK) {
-                rockCount++;
-            // } else if(readCharacter == EMPTY) {
-                // do nothing
-            } else if (readCharacter == CUBE_ROCK) {
-                for (unsigned int i=0; i < rockCount; i++) {
-                    movedMap[rC.y+(i+1)][rC.x] = ROLLING_ROCK;    //+1 to start before the CUBE_ROCK
+    // Moves the rocks of every row up (direction -1) or down (+1) as far as they go.
+    // The rows already passed have settled, so a row's rocks are pushed along until none of them moves anymore.
+    void tiltVertically(int direction) {
+        const int rows = static_cast<int>(height);
+        // Start at the row next to the edge the rocks roll towards.
+        for (int y = (direction < 0 ? 1 : rows - 2); y >= 0 && y < rows; y -= direction) {
+            std::copy(getRow(rollingRocks, y), getRow(rollingRocks, y) + wordsPerRow, moving.begin());
+            for (int from = y; from + direction >= 0 && from + direction < rows; from += direction) {
+                word * fromRow = getRow(rollingRocks, from);
+                word * toRow = getRow(rollingRocks, from + direction);
+                const word * toCubes = getRow(cubeRocks, from + direction);
+                word anyMoved = 0;
+                for (size_t i = 0; i < wordsPerRow; i++) {
+                    moving[i] &= ~(toRow[i] | toCubes[i]);
+                    fromRow[i] &= ~moving[i];
+                    toRow[i] |= moving[i];
+                    anyMoved |= moving[i];
+                }
+                if (!anyMoved) {
+                    break;
                 }
-                rockCount = 0;
             }
         }
-        // Make sure the rolling rocks don't roll off the edge.
-        for (unsigned int i=0; i < rockCount; i++) {
-            movedMap[0+i][x] = ROLLING_ROCK;
-        }
     }
 
-    std::swap(movedMap, _movedMap);
-}
-
-void moveRollingRocksSouthwards(const std::vector<std::vector<char> > & initialMap, std::vector<std::vector<char> > & _movedMap) {
-    assert(!initialMap.empty());
-    
-    std::vector<std::vector<char> > movedMap;
-    copyMapExceptRollingRocks(initialMap, movedMap);
-    assert(movedMap.size() == initialMap.size());
-    assert(movedMap[0].size() == initialMap[0].size());
-
-    // Copy the rolling rocks as if they moved upwards
-    for (size_t x=0; x < initialMap[0].size(); x++) {
-        unsigned int rockCount = 0;
-        for (size_t y=0; y < initialMap.size(); y++) {
-            // calculate read coordinates
-            TCoordinates<size_t> rC{x, y};  //-1 to convert to indices.     [rC]: Read Coordinates
-            const char & readCharacter = initialMap[rC.y][rC.x];
-            if (readCharacter == ROLLING_ROCK) {
-                rockCount++;
-            // } else if(readCharacter == EMPTY) {
-                // do nothing
-            } else if (readCharacter == CUBE_ROCK) {
-                for (unsigned int i=0; i < rockCount; i++) {
-                    movedMap[rC.y-(i+1)][rC.x] = ROLLING_ROCK;    //+1 to start before the CUBE_ROCK
+    // Packs the rocks between two cube rocks against the west (towardsEnd false) or the east side of that run.
+    void tiltHorizontally(bool towardsEnd) {
+        for (size_t y = 0; y < height; y++) {
+            word * row = getRow(rollingRocks, y);
+            for (const auto & [begin, end] : segments[y]) {
+                size_t rocks = 0;
+                forEachWord(row, begin, end, [&rocks](word & bits, word mask) {
+                    rocks += std::popcount(bits & mask);
+                    bits &= ~mask;
+                });
+                if (towardsEnd) {
+                    forEachWord(row, end - rocks, end, [](word & bits, word mask) { bits |= mask; });
+                } else {
+                    forEachWord(row, begin, begin + rocks, [](word & bits, word mask) { bits |= mask; });
                 }
-                rockCount = 0;
             }
         }
-        // Make sure the rolling rocks don't roll off the edge.
-        for (unsigned int i=0; i < rockCount; i++) {
-            movedMap[initialMap.size()-1-i][x] = ROLLING_ROCK; //-1 to convert initialMap.size() to indices
-        }
     }
 
-    std::swap(movedMap, _movedMap);
-}
-
-void moveRollingRocksEastwards(const std::vector<std::vector<char> > & initialMap, std::vector<std::vector<char> > & _movedMap) {
-    assert(!initialMap.empty());
-    
-    std::vector<std::vector<char> > movedMap;
-    copyMapExceptRollingRocks(initialMap, movedMap);
-    assert(movedMap.size() == initialMap.size());
-    assert(movedMap[0].size() == initialMap[0].size());
-
-    // Copy the rolling rocks as if they moved upwards
-    for (size_t y=0; y < initialMap.size(); y++) {
-        unsigned int rockCount = 0;
-        for (size_t x=0; x < initialMap[0].size(); x++) {
-            // calculate read coordinates
-            TCoordinates<size_t> rC{x, y};  //-1 to convert to indices.     [rC]: Read Coordinates
-            const char & readCharacter = initialMap[rC.y][rC.x];
-            if (readCharacter == ROLLING_ROCK) {
-                rockCount++;
-            // } else if(readCharacter == EMPTY) {
-                // do nothing
-            } else if (readCharacter == CUBE_ROCK) {
-                for (unsigned int i=0; i < rockCount; i++) {
-                    movedMap[rC.y][rC.x-(i+1)] = ROLLING_ROCK;    //+1 to start before the CUBE_ROCK
+public:
+    Platform(const Grid<char> & map) :
+        width(map.getWidth()),
+        height(map.getHeight()),
+        wordsPerRow((map.getWidth() + WORD_BITS - 1) / WORD_BITS),
+        cubeRocks(wordsPerRow * height, 0),
+        rollingRocks(wordsPerRow * height, 0),
+        segments(height),
+        moving(wordsPerRow, 0)
+    {
+        for (size_t y=0; y < height; y++) {
+            size_t begin = 0;
+            for (size_t x=0; x < width; x++) {
+                const word bit = word(1) << (x % WORD_BITS);
+                if (map.at(x, y) == CUBE_ROCK) {
+                    getRow(cubeRocks, y)[x / WORD_BITS] |= bit;
+                    if (begin != x) {
+                        segments[y].emplace_back(begin, x);
+                    }
+                    begin = x + 1;
+                } else if (map.at(x, y) == ROLLING_ROCK) {
+                    getRow(rollingRocks, y)[x / WORD_BITS] |= bit;
                 }
-                rockCount = 0;
+            }
+            if (begin != width) {
+                segments[y].emplace_back(begin, width);
             }
         }
-        // Make sure the rolling rocks don't roll off the edge.
-        for (unsigned int i=0; i < rockCount; i++) {
-            movedMap[y][initialMap[0].size()-(1+i)] = ROLLING_ROCK;      //-1 to convert initialMap.size() to indices
+    }
+
+    void tiltNorth() {
+        tiltVertically(-1);
+    }
+
+    void tiltSouth() {
+        tiltVertically(1);
+    }
+
+    void tiltWest() {
+        tiltHorizontally(false);
+    }
+
+    void tiltEast() {
+        tiltHorizontally(true);
+    }
+
+    void spinCycle() {
+        tiltNorth();
+        tiltWest();
+        tiltSouth();
+        tiltEast();
+    }
+
+    // Every rolling rock weighs as much as its distance to the south edge, counting its own row.
+    puzzleValueType getNorthLoad() const {
+        puzzleValueType load = 0;
+        for (size_t y=0; y < height; y++) {
+            const word * row = getRow(rollingRocks, y);
+            for (size_t i=0; i < wordsPerRow; i++) {
+                load += std::popcount(row[i]) * (height - y);
+            }
         }
+        return load;
     }
 
-    std::swap(movedMap, _movedMap);
-}
+    const std::vector<word> & getRollingRocks() const {
+        return rollingRocks;
+    }
 
-void moveRollingRocksWestwards(const std::vector<std::vector<char> > & initialMap, std::vector<std::vector<char> > & _movedMap) {
-    assert(!initialMap.empty());
-    
-    std::vector<std::vector<char> > movedMap;
-    copyMapExceptRollingRocks(initialMap, movedMap);
-    assert(movedMap.size() == initialMap.size());
-    assert(movedMap[0].size() == initialMap[0].size());
-
-    // Copy the rolling rocks as if they moved upwards
-    for (size_t y=0; y < initialMap.size(); y++) {
-        unsigned int rockCount = 0;
-        for (size_t x=0; x < initialMap[0].size(); x++) {
-            // calculate read coordinates
-            TCoordinates<size_t> rC{initialMap[0].size()-(1+x), y};  //-1 to convert to indices.     [rC]: Read Coordinates
-            const char & readCharacter = initialMap[rC.y][rC.x];
-            if (readCharacter == ROLLING_ROCK) {
-                rockCount++;
-            // } else if(readCharacter == EMPTY) {
-                // do nothing
-            } else if (readCharacter == CUBE_ROCK) {
-                for (unsigned int i=0; i < rockCount; i++) {
-                    movedMap[rC.y][rC.x+(i+1)] = ROLLING_ROCK;    //+1 to start before the CUBE_ROCK
+    void print(std::string_view name) const {
+        LOG(debug, name << ":");
+        for (size_t y=0; y < height; y++) {
+            for (size_t x=0; x < width; x++) {
+                const word bit = word(1) << (x % WORD_BITS);
+                if (getRow(cubeRocks, y)[x / WORD_BITS] & bit) {
+                    LOG_PART(debug, CUBE_ROCK);
+                } else if (getRow(rollingRocks, y)[x / WORD_BITS] & bit) {
+                    LOG_PART(debug, ROLLING_ROCK);
+                } else {
+                    LOG_PART(debug, EMPTY);
                 }
-                rockCount = 0;
             }
-        }
-        // Make sure the rolling rocks don't roll off the edge.
-        for (unsigned int i=0; i < rockCount; i++) {
-            movedMap[y][0+i] = ROLLING_ROCK;
+            LOG(debug, "");
         }
     }
-
-    std::swap(movedMap, _movedMap);
-}
+};
 
 template<typename T>
 puzzleValueType solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // convert to map
-    std::vector<std::vector<char> > map;
+    Grid<char> map;
     {
         bool equalLinesInMap = VectorUtils::convertToMap(lines, map);
         assert(equalLinesInMap);
     }
 
+    Platform platform(map);
+
+    Runner::markParsed();
+
     // move all roling rocks upwards
-    // CoutUtils::print2d("initialMap", map);
-    // std::cout << std::endl;
-    moveRollingRocksNorthwards(map, map);
-    // CoutUtils::print2d("movedMap", map);
+    platform.print("initialMap");
+    platform.tiltNorth();
+    platform.print("movedMap");
 
-    // Count puzzle value
-    puzzleValueType puzzleValue = 0;
-    for (size_t x=0; x < map[0].size(); x++) {
-        for (size_t y=0; y < map.size(); y++) {
-            TCoordinates<size_t> rC{x, map.size()-y-1};  //-1 to convert to indices.     [rC]: Read Coordinates
-            const char & readCharacter = map[rC.y][rC.x];
-            if (readCharacter == ROLLING_ROCK) {
-                puzzleValue += map.size()-rC.y;    // higher is more weight; so the weight increases in the opposing direction as the (rC.)y index.
-            }
-        }
-    }
+    puzzleValueType puzzleValue = platform.getNorthLoad();
 
     return puzzleValue;
 }
@@ -359,80 +374,86 @@ puzzleValueType solve1(T & stream) {
 
 // Although it hasn't changed, you can still get your puzzle input.
 
-const std::string givenTestData_problem2 = "\
-.....#....\n\
-....#...O#\n\
-...OO##...\n\
-.OO#......\n\
-.....OOO#.\n\
-.O#...O#.#\n\
-....O#....\n\
-......OOOO\n\
-#...O###..\n\
-#..OO#....\n";
+// The example starts from the same platform, the load of 64 is after all 1000000000 cycles.
+const std::string & givenTestData_problem2 = givenTestData_problem1;
 
 constexpr puzzleValueType expectedSolution_problem2 = 64;
 
 constexpr unsigned long int CYCLES = 1000000000;
 
+struct BitboardHash {
+    size_t operator()(const std::vector<uint64_t> & bitboard) const {
+        size_t hash = bitboard.size();
+        for (const auto & word : bitboard) {
+            hash ^= std::hash<uint64_t>()(word) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
 template<typename T>
 puzzleValueType solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // convert to map
-    std::vector<std::vector<char> > map;
+    Grid<char> map;
     {
         bool equalLinesInMap = VectorUtils::convertToMap(lines, map);
         assert(equalLinesInMap);
     }
 
-    // move all roling rocks upwards
-    CoutUtils::print2d("initialMap", map);
-    std::cout << std::endl;
-    unsigned long int printCounter = 0;
-    for (unsigned long int cycle = 0; cycle < CYCLES; cycle++) {
-        if (printCounter == 1000) {
-            printCounter = 0;
-            PRINT(cycle);
-        }
-        printCounter++;
-        //north ^
-        moveRollingRocksNorthwards(map, map);
-        //west <-
-        moveRollingRocksWestwards(map, map);
-        //south \/
-        moveRollingRocksSouthwards(map, map);
-        // east ->
-        moveRollingRocksEastwards(map, map);
-    }
-    CoutUtils::print2d("movedMap", map);
+    Platform platform(map);
 
-    // Count puzzle value
+    Runner::markParsed();
+
+    // The rocks settle into a loop of states after a while; remember every state seen (and the load it had)
+    //  until one comes back, then the state after CYCLES cycles lies that far into the loop.
+    platform.print("initialMap");
+    std::unordered_map<std::vector<uint64_t>, unsigned long int, BitboardHash> cycleOfState;
+    std::vector<puzzleValueType> loadAfterCycle;
     puzzleValueType puzzleValue = 0;
-    for (size_t x=0; x < map[0].size(); x++) {
-        for (size_t y=0; y < map.size(); y++) {
-            TCoordinates<size_t> rC{x, map.size()-y-1};  //-1 to convert to indices.     [rC]: Read Coordinates
-            const char & readCharacter = map[rC.y][rC.x];
-            if (readCharacter == ROLLING_ROCK) {
-                puzzleValue += map.size()-rC.y;    // higher is more weight; so the weight increases in the opposing direction as the (rC.)y index.
-            }
+    for (unsigned long int cycle = 0; ; cycle++) {
+        const auto [seen, isNew] = cycleOfState.emplace(platform.getRollingRocks(), cycle);
+        if (!isNew) {
+            const unsigned long int loopStart = seen->second;
+            const unsigned long int loopLength = cycle - loopStart;
+            LOG(debug, "state after cycle " << cycle << " was seen after cycle " << loopStart << ", loop length:" << loopLength);
+            puzzleValue = loadAfterCycle[loopStart + (CYCLES - loopStart) % loopLength];
+            break;
+        }
+        loadAfterCycle.push_back(platform.getNorthLoad());
+        if (cycle == CYCLES) {
+            puzzleValue = loadAfterCycle.back();
+            break;
         }
+        platform.spinCycle();
     }
+    platform.print("movedMap");
 
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(14, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
+
+}; // namespace day14
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day14;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -450,21 +471,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
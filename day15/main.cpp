@@ -1,22 +1,33 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <list>
-#include <queue>
-#include <set>
-#include <sstream>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace day15 {
+
 
 using puzzleValueType = long long int;
 
@@ -108,39 +119,74 @@ const std::string givenTestData_problem1 = "rn=1,cm-,qp=3,cm=2,qp-,pc=4,ot=9,ab=
 
 constexpr puzzleValueType expectedSolution_problem1 = 1320;
 
-uint8_t hash(const std::string & toHash, unsigned int currentValue = 0) {
-
+inline uint8_t hash(std::string_view toHash) {
+    uint8_t currentValue = 0;   //wraps around at 256 by itself
     for (const auto & c : toHash) {
-        currentValue += (int)c;
-        currentValue *= 17;
-        currentValue %= 256;
+        currentValue = (currentValue + static_cast<unsigned char>(c)) * 17;
     }
-
-    return static_cast<uint8_t>(currentValue);
+    return currentValue;
 }
 
-
-template<typename T>
-puzzleValueType solve1(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
-    }
-
-    // Convert input to commands.
-    std::vector<std::string> commands;
-    for (const auto & line : lines) {
-        auto commandsInLine = StringUtils::split(line, ",");
-        for (const auto & commandInLine : commandsInLine) {
-            commands.push_back(commandInLine);
+// HASH(step) = sum(c * 17^distance) (mod 256), with the distance counted from the end of the step: 1 for its last character.
+// From HASH_MULTIPLIERS + 16 - n on, lane k holds that factor for character k of an n character step and 0 past its end,
+//  so a step shorter than 16 characters hashes with a single 16-lane multiply and a byte sum.
+constexpr std::array<uint8_t, 32> HASH_MULTIPLIERS = []() {
+    std::array<uint8_t, 32> multipliers{};
+    uint8_t multiplier = 1;
+    for (size_t distance = 1; distance <= 16; distance++) {
+        multiplier *= 17;
+        multipliers[16 - distance] = multiplier;
+    }
+    return multipliers;
+}();
+
+// Calls stepFunction(step, HASH(step)) for every non-empty comma separated step of sequence.
+template<typename F>
+void hashSteps(std::string_view sequence, F stepFunction) {
+    const char * data = sequence.data();
+    const size_t size = sequence.size();
+#if defined(__SSE2__)
+    const __m128i commas = _mm_set1_epi8(',');
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lowBytes = _mm_set1_epi16(0xFF);
+#endif
+    for (size_t begin = 0; begin < size;) {
+#if defined(__SSE2__)
+        if (begin + 16 <= size) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + begin));
+            const unsigned int commaMask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, commas)));
+            if (commaMask != 0) {
+                const size_t length = __builtin_ctz(commaMask);
+                if (length != 0) {
+                    const __m128i multipliers = _mm_loadu_si128(reinterpret_cast<const __m128i *>(HASH_MULTIPLIERS.data() + 16 - length));
+                    const __m128i low = _mm_mullo_epi16(_mm_unpacklo_epi8(block, zero), _mm_unpacklo_epi8(multipliers, zero));
+                    const __m128i high = _mm_mullo_epi16(_mm_unpackhi_epi8(block, zero), _mm_unpackhi_epi8(multipliers, zero));
+                    // keep the products modulo 256 and add them up, per 8 lanes
+                    const __m128i sums = _mm_sad_epu8(_mm_packus_epi16(_mm_and_si128(low, lowBytes), _mm_and_si128(high, lowBytes)), zero);
+                    stepFunction(sequence.substr(begin, length), static_cast<uint8_t>(_mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4)));
+                }
+                begin += length + 1;
+                continue;
+            }
+        }
+#endif
+        // scalar fallback, steps of 16 characters or more, and the tail that doesn't fill a whole register
+        const size_t end = std::min(sequence.find(',', begin), size);
+        if (end != begin) {
+            const std::string_view step = sequence.substr(begin, end - begin);
+            stepFunction(step, hash(step));
         }
+        begin = end + 1;
     }
+}
 
-    // Hash the commands.
+template<typename T>
+puzzleValueType solve1(T & stream) {
     puzzleValueType puzzleValue = 0;
-    for (const auto & command : commands) {
-        puzzleValue += hash(command);
+    for (std::string_view line; InputUtils::getline(stream, line);) {
+        hashSteps(line, [&puzzleValue](std::string_view, uint8_t hashValue) {
+            puzzleValue += hashValue;
+        });
     }
 
     return puzzleValue;
@@ -265,33 +311,91 @@ constexpr char REMOVE_LENS = '-';
 
 // std::unordered_map<uint8_t, Box>
 
+// A lens label in 16 bytes, so lenses need no allocation of their own and compare as two words.
+// Labels up to CAPACITY characters are kept inline, zero padded. A longer label lives with the box it belongs to;
+//  the label then holds its index there instead, and the last byte marks it as long.
+class Label {
+public:
+    static constexpr size_t CAPACITY = 15;
+
+private:
+    static constexpr char LONG_LABEL = 1;
+
+    std::array<char, CAPACITY + 1> characters{};
+
+public:
+    Label() {}
+    explicit Label(std::string_view label) {
+        assert(label.size() <= CAPACITY);
+        std::copy_n(label.begin(), std::min(label.size(), CAPACITY), characters.begin());
+    }
+
+    static Label makeLong(uint32_t index) {
+        Label ret;
+        std::memcpy(ret.characters.data(), &index, sizeof(index));
+        ret.characters[CAPACITY] = LONG_LABEL;
+        return ret;
+    }
+
+    bool isLong() const {
+        return characters[CAPACITY] == LONG_LABEL;
+    }
+
+    // only valid if isLong() == true
+    uint32_t getLongIndex() const {
+        uint32_t ret;
+        std::memcpy(&ret, characters.data(), sizeof(ret));
+        return ret;
+    }
+
+    // only valid if isLong() == false
+    std::string_view getView() const {
+        return std::string_view(characters.data(), std::find(characters.begin(), characters.end(), '\0') - characters.begin());
+    }
+
+    bool operator==(const Label & rhs) const {
+        return characters == rhs.characters;
+    }
+
+    struct Hash {
+        size_t operator()(const Label & label) const {
+            uint64_t words[2];
+            std::memcpy(words, label.characters.data(), sizeof(words));
+            return (words[0] * 0x9E3779B97F4A7C15ull) ^ (words[1] * 0xC2B2AE3D27D4EB4Full) ^ (words[0] >> 29);
+        }
+    };
+};
+static_assert(sizeof(Label) == 16);
+
+// One step, parsed in place: the label, and either '-' or '=' with a focal length.
+// The label stays a view into the input; the box it goes to turns it into a Label.
 class Command {
 private:
-    std::string label;
+    std::string_view label;
     uint8_t hashValue;
     bool add;
     // only valid if add == true;
-    uint8_t focalLength;
+    uint8_t focalLength = 0;
 
 public:
-    Command(const std::string & command) {
-        if (StringUtils::contains(command, {ADD_LENS})) {
-            add = true;
-            auto splitCommand = StringUtils::split(command, {ADD_LENS});
-            label = splitCommand[0];
-            focalLength = std::stoi(splitCommand[1]);
-        } else { //if (StringUtils::contains(command, {REMOVE_LENS})) {
-            add = false;
-            label = StringUtils::remove(command, {REMOVE_LENS});
-        }
+    Command(std::string_view command) {
+        const size_t operation = command.find_first_of(std::string_view{"=-"});
+        assert(operation != std::string_view::npos);
+        label = command.substr(0, operation);
         hashValue = hash(label);
+        add = (command[operation] == ADD_LENS);
+        if (add) {
+            focalLength = StringUtils::toNumber<int>(command.substr(operation + 1));
+        } else {
+            assert(command[operation] == REMOVE_LENS);
+        }
     }
 
     bool isAddCommand() const {
         return add;
     }
 
-    const std::string & getLabel() const {
+    std::string_view getLabel() const {
         return label;
     }
 
@@ -306,12 +410,20 @@ public:
 
 class Lens {
 private:
+    Label label;
     uint8_t focalLength;
     bool removed = false;
+
 public:
-    Lens(const uint8_t & focalLength)
-        : focalLength(focalLength)
+    Lens(const Label & label, const uint8_t & focalLength)
+        : label(label),
+          focalLength(focalLength)
     {
+
+    }
+
+    const Label & getLabel() const {
+        return label;
     }
 
     void setFocalLength(const uint8_t & focalLength) {
@@ -329,55 +441,121 @@ public:
     void setRemoved() {
         removed = true;
     }
-
-    std::string toString() const {
-        return std::string("[") + std::to_string(focalLength) + "]";
-    }
 };
 
+// The lenses of a box in order, in one flat vector. A box with few lenses is searched by scanning them;
+//  once the vector outgrows INDEX_THRESHOLD, an index from label to position keeps every step O(1).
+// A removed lens stays behind as a tombstone until they make up half of the vector,
+//  then they are all dropped at once; the vector never holds more than twice the lenses in the box.
 class Box {
 private:
+    static constexpr size_t INDEX_THRESHOLD = 16;
+
     size_t index = -1;
-    std::list<Lens*> lensList;
-    std::unordered_map<std::string, Lens*> lensMap;     // label -> Lens
+    std::vector<Lens> lenses;
+    bool indexed = false;
+    std::unordered_map<Label, uint32_t, Label::Hash> positions;    //only if indexed: label of every lens in the box -> index in lenses
+    size_t removedCount = 0;
+    // Labels above Label::CAPACITY, each kept once for as long as the box exists; a deque never moves them,
+    //  so the index can key on views of them.
+    std::deque<std::string> longLabels;
+    std::unordered_map<std::string_view, uint32_t> longLabelIndices;
+
+    // The label as it is stored in this box; nothing for a long label this box has never seen.
+    std::optional<Label> findLabel(std::string_view label) const {
+        if (label.size() <= Label::CAPACITY) {
+            return Label(label);
+        }
+        const auto longLabel = longLabelIndices.find(label);
+        if (longLabel == longLabelIndices.end()) {
+            return std::nullopt;
+        }
+        return Label::makeLong(longLabel->second);
+    }
+
+    Label addLabel(std::string_view label) {
+        if (auto ret = findLabel(label)) {
+            return *ret;
+        }
+        const uint32_t longIndex = longLabels.size();
+        const std::string & longLabel = longLabels.emplace_back(label);
+        longLabelIndices.emplace(longLabel, longIndex);
+        return Label::makeLong(longIndex);
+    }
+
+    std::string_view getView(const Label & label) const {
+        return label.isLong()? std::string_view(longLabels[label.getLongIndex()]) : label.getView();
+    }
+
+    Lens * find(const Label & label) {
+        if (indexed) {
+            const auto position = positions.find(label);
+            return (position != positions.end())? &lenses[position->second] : nullptr;
+        }
+        for (auto & lens : lenses) {
+            if (!lens.isRemoved() && lens.getLabel() == label) {
+                return &lens;
+            }
+        }
+        return nullptr;
+    }
+
+    void updateIndex() {
+        indexed = indexed || lenses.size() > INDEX_THRESHOLD;
+        if (indexed) {
+            for (uint32_t i=0; i < lenses.size(); i++) {
+                if (!lenses[i].isRemoved()) {
+                    positions[lenses[i].getLabel()] = i;
+                }
+            }
+        }
+    }
+
+    void compact() {
+        std::erase_if(lenses, [](const Lens & lens) { return lens.isRemoved(); });
+        removedCount = 0;
+        updateIndex();
+    }
 
 public:
     void executeCommand(const Command & command) {
-        const auto & label = command.getLabel();
         if (command.isAddCommand()) {
-            if (lensMap.contains(label)) {
+            const Label label = addLabel(command.getLabel());
+            if (Lens * lens = find(label)) {
                 // Replace the old lens with a new lens
-                lensMap[label]->setFocalLength(command.getFocalLength());
+                lens->setFocalLength(command.getFocalLength());
             } else {
-                // does not yet exist
-                Lens * newLens = new Lens(command.getFocalLength());
-                lensMap[label] = newLens;
-                lensList.push_back(newLens);
+                lenses.emplace_back(label, command.getFocalLength());
+                if (indexed) {
+                    positions.emplace(label, lenses.size() - 1);
+                } else if (lenses.size() > INDEX_THRESHOLD) {
+                    updateIndex();
+                }
             }
-        } else {
-            if (lensMap.contains(label)) {
-                lensMap[label]->setRemoved();
-                lensMap.erase(label);   //remove it only from the unordered_map. No need to clean up for the puzzle. Probably.
+        } else if (const auto label = findLabel(command.getLabel())) {
+            if (Lens * lens = find(*label)) {
+                lens->setRemoved();
+                if (indexed) {
+                    positions.erase(*label);
+                }
+                if (2 * ++removedCount >= lenses.size()) {
+                    compact();
+                }
             }
         }
     }
 
-    void print() {
-        bool hasLenses = false;
-        for (Lens * lens : lensList) {
-            if (!lens->isRemoved()) {
-                hasLenses = true;
-            }
+    void print() const {
+        if (lenses.size() == removedCount) {
+            return;
         }
-        if (hasLenses) {
-            std::cout << "box:[" << index << "]";
-            for (Lens * lens : lensList) {
-                if (!lens->isRemoved()) {
-                    std::cout << lens->toString() << " ";
-                }
+        LOG_PART(debug, "box:[" << index << "]");
+        for (const Lens & lens : lenses) {
+            if (!lens.isRemoved()) {
+                LOG_PART(debug, "[" << getView(lens.getLabel()) << " " << static_cast<int>(lens.getFocalLength()) << "] ");
             }
-            std::cout << std::endl;
         }
+        LOG(debug, "");
     }
 
     void setIndex(const size_t & index) {
@@ -386,78 +564,68 @@ public:
 
     puzzleValueType computeFocussingPower() const {
         puzzleValueType ret=0;
-
         // One plus the box number of the lens in question.
         const puzzleValueType boxMultiplier = 1 + index;
         puzzleValueType lensCounter = 1;
-        for (Lens * lens : lensList) {
+        for (const Lens & lens : lenses) {
             // The slot number of the lens within the box: 1 for the first lens, 2 for the second lens, and so on.
-            if (!lens->isRemoved()){
-                ret += boxMultiplier * lens->getFocalLength() * lensCounter;
+            if (!lens.isRemoved()){
+                ret += boxMultiplier * lens.getFocalLength() * lensCounter;
                 lensCounter++;
             }
         }
-
         return ret;
     }
 };
 
 template<typename T>
 puzzleValueType solve2(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
-    }
-
-    // Convert input to command strings.
-    std::vector<std::string> commandStrings;
-    for (const auto & line : lines) {
-        auto commandsInLine = StringUtils::split(line, ",");
-        for (const auto & commandInLine : commandsInLine) {
-            commandStrings.push_back(commandInLine);
-        }
-    }
-
-    // Convert command strings to command objects
-    std::vector<Command> commands;
-    for (const auto & commandString : commandStrings) {
-        commands.emplace_back(commandString);
-    }
-
     // Create a list of boxes
     std::array<Box, 256> boxes;
     for (size_t i=0; i < boxes.size(); i++) {
         boxes[i].setIndex(i);
     }
 
-    // Execute commands on boxes
-    for (const Command & command : commands) {
-        auto hashValue = command.getHashValue();
-        boxes[hashValue].executeCommand(command);
+    // Execute every step on its box as soon as it's read; nothing is kept but the boxes
+    for (std::string_view line; InputUtils::getline(stream, line);) {
+        for (std::string_view step : StringUtils::splitView(line, ",")) {
+            if (!step.empty()) {
+                const Command command(step);
+                boxes[command.getHashValue()].executeCommand(command);
+            }
+        }
     }
 
-    // for (auto & box : boxes) {
-    //     box.print();
-    // }
-
+    for (const Box & box : boxes) {
+        box.print();
+    }
 
     // Calculate puzzle value
     puzzleValueType puzzleValue = 0;
-    for (Box & box : boxes) {
+    for (const Box & box : boxes) {
         puzzleValue += box.computeFocussingPower();
     }
 
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(15, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
+
+}; // namespace day15
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day15;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -475,21 +643,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
@@ -1,21 +1,25 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "Grid.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
 #include <cassert>
 #include <cctype>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 
+namespace day16 {
+
 
 using puzzleValueType = long long int;
 
@@ -120,13 +124,7 @@ constexpr char VERTICAL_SPLITTER = '|';
 constexpr char HORIZONTAL_SPLITTER = '-';
 constexpr char MIRROR1 = '\\';
 constexpr char MIRROR2 = '/';
-
-enum direction_e {
-    e_north,
-    e_east,
-    e_south,
-    e_west
-};
+constexpr char OUTSIDE = ' ';      // border around the map, absorbs any beam leaving it
 
 using ICoordinates = TCoordinates<int>;
 
@@ -154,8 +152,8 @@ public:
 
 class Space {
 private:
-    const ICoordinates coordinates;
-    const char character;
+    ICoordinates coordinates;
+    char character;
     bool energized = false;
 
     bool north = false;
@@ -325,69 +323,64 @@ private:
     }
 };
 
+// The map gets a border of OUTSIDE spaces, a beam leaving the map ends there without any bounds check.
+Grid<Space> makeMap(const std::vector<std::string_view> & lines) {
+    const int width = lines.empty()? 0 : lines[0].size();
+    Grid<Space> map(width, lines.size(), Space({0,0}, EMPTY_SPACE), 1, Space({-1,-1}, OUTSIDE));
+    for (int y=0; y < static_cast<int>(lines.size()); y++) {
+        for (int x=0; x < static_cast<int>(lines[y].size()) && x < width; x++) {
+            map.at(x, y) = Space({x,y}, lines[y][x]);
+        }
+    }
+    return map;
+}
+
 template<typename T>
 puzzleValueType solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     //convert lines into items
-    std::vector<std::vector<Space>> map;
-    {
-        int y=0;
-        for (const auto & line : lines) {
-            int x=0;
-            std::vector<Space> spacesLine;
-            for (const char & c : line) {
-                spacesLine.push_back(Space({x,y}, c));
-                x++;
-            }
-            map.push_back(spacesLine);
-            y++;
-        }
-    }
+    Grid<Space> map = makeMap(lines);
 
-    for (const auto & spaceRow : map) {
-        for (const auto & space : spaceRow) {
-            std::cout << space.getCharacter();
+    for (size_t y=0; y < map.getHeight(); y++) {
+        for (const auto & space : map.row(y)) {
+            LOG_PART(trace, space.getCharacter());
         }
-        std::cout << std::endl;
+        LOG(trace, "");
     }
 
+    Runner::markParsed();
+
     // play out beam scenario
     std::queue<Beam> beams;
     beams.emplace(ICoordinates{0,0}, direction_e::e_east);
     while (!beams.empty()) {
         const Beam & beam = beams.front();
-        const auto & beamCoordinates = beam.getCoordinates();
-        if ((beamCoordinates.y >= 0 && beamCoordinates.y < map.size())
-            && (beamCoordinates.x >= 0 && beamCoordinates.x < map[0].size()))
-        {
-            Space & space = map[beamCoordinates.y][beamCoordinates.x];
-            space.beamEvent(beam, beams);
-        }
+        map[beam.getCoordinates()].beamEvent(beam, beams);
         beams.pop();
     }
-    std::cout << std::endl;
+    LOG(trace, "");
 
     // print energized spaces
-    for (const auto & spaceRow : map) {
-        for (const auto & space : spaceRow) {
+    for (size_t y=0; y < map.getHeight(); y++) {
+        for (const auto & space : map.row(y)) {
             if (space.isEnergized()) {
-                std::cout << "#";
+                LOG_PART(trace, "#");
             } else {
-                std::cout << space.getCharacter();
+                LOG_PART(trace, space.getCharacter());
             }
         }
-        std::cout << std::endl;
+        LOG(trace, "");
     }
 
     // count energized spaces
     puzzleValueType puzzleValue = 0;
-    for (const auto & spaceRow : map) {
-        for (const auto & space : spaceRow) {
+    for (size_t y=0; y < map.getHeight(); y++) {
+        for (const auto & space : map.row(y)) {
             if (space.isEnergized()) {
                 puzzleValue++;
             }
@@ -441,26 +434,20 @@ const std::string & givenTestData_problem2 = givenTestData_problem1;
 
 constexpr puzzleValueType expectedSolution_problem2 = 51;
 
-puzzleValueType runAndCount(const Beam & beam, std::vector<std::vector<Space>> map) {
+puzzleValueType runAndCount(const Beam & beam, Grid<Space> map) {
     std::queue<Beam> beams;
     beams.push(beam);
 
     while (!beams.empty()) {
         const Beam & beam = beams.front();
-        const auto & beamCoordinates = beam.getCoordinates();
-        if ((beamCoordinates.y >= 0 && beamCoordinates.y < map.size())
-            && (beamCoordinates.x >= 0 && beamCoordinates.x < map[0].size()))
-        {
-            Space & space = map[beamCoordinates.y][beamCoordinates.x];
-            space.beamEvent(beam, beams);
-        }
+        map[beam.getCoordinates()].beamEvent(beam, beams);
         beams.pop();
     }
 
     // count energized spaces
     puzzleValueType puzzleValue = 0;
-    for (const auto & spaceRow : map) {
-        for (const auto & space : spaceRow) {
+    for (size_t y=0; y < map.getHeight(); y++) {
+        for (const auto & space : map.row(y)) {
             if (space.isEnergized()) {
                 puzzleValue++;
             }
@@ -473,55 +460,54 @@ puzzleValueType runAndCount(const Beam & beam, std::vector<std::vector<Space>> m
 template<typename T>
 puzzleValueType solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     //convert lines into items
-    std::vector<std::vector<Space>> map;
-    {
-        int y=0;
-        for (const auto & line : lines) {
-            int x=0;
-            std::vector<Space> spacesLine;
-            for (const char & c : line) {
-                spacesLine.push_back(Space({x,y}, c));
-                x++;
-            }
-            map.push_back(spacesLine);
-            y++;
-        }
-    }
+    Grid<Space> map = makeMap(lines);
 
-    for (const auto & spaceRow : map) {
-        for (const auto & space : spaceRow) {
-            std::cout << space.getCharacter();
+    for (size_t y=0; y < map.getHeight(); y++) {
+        for (const auto & space : map.row(y)) {
+            LOG_PART(trace, space.getCharacter());
         }
-        std::cout << std::endl;
+        LOG(trace, "");
     }
 
+    Runner::markParsed();
+
     // play out beam scenario
     puzzleValueType puzzleValue = 0;
-    for (unsigned int y=0; y < map.size(); y++) {
+    for (unsigned int y=0; y < map.getHeight(); y++) {
         puzzleValue = std::max(puzzleValue, runAndCount(Beam(ICoordinates{0,static_cast<int>(y)}, direction_e::e_east), map));
-        puzzleValue = std::max(puzzleValue, runAndCount(Beam(ICoordinates{static_cast<int>(map[0].size()-1),static_cast<int>(y)}, direction_e::e_west), map));
+        puzzleValue = std::max(puzzleValue, runAndCount(Beam(ICoordinates{static_cast<int>(map.getWidth()-1),static_cast<int>(y)}, direction_e::e_west), map));
     }
-    for (unsigned int x=0; x < map[0].size(); x++) {
+    for (unsigned int x=0; x < map.getWidth(); x++) {
         puzzleValue = std::max(puzzleValue, runAndCount(Beam(ICoordinates{static_cast<int>(x),0}, direction_e::e_south), map));
-        puzzleValue = std::max(puzzleValue, runAndCount(Beam(ICoordinates{static_cast<int>(x),static_cast<int>(map.size()-1)}, direction_e::e_north), map));
+        puzzleValue = std::max(puzzleValue, runAndCount(Beam(ICoordinates{static_cast<int>(x),static_cast<int>(map.getHeight()-1)}, direction_e::e_north), map));
     }
 
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(16, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
+
+}; // namespace day16
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day16;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -539,21 +525,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
@@ -1,21 +1,25 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "Grid.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
 #include <cassert>
 #include <cctype>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 
+namespace day17 {
+
 
 using puzzleValueType = long long int;
 
@@ -112,13 +116,6 @@ constexpr puzzleValueType expectedSolution_problem1 = 102;
 
 constexpr unsigned int MAXIMUM_STRAIGHT_MOVES = 3;
 
-enum direction_e {
-    e_north,
-    e_east,
-    e_south,
-    e_west
-};
-
 class Crucible {
 private:
     ICoordinates coordinates;
@@ -148,14 +145,14 @@ public:
 
 class Block {
 private:
-    const unsigned int heatLoss;
+    unsigned int heatLoss;
     std::array<unsigned int, MAXIMUM_STRAIGHT_MOVES> bestHistory;
 public:
     Block(const unsigned int & heatLoss)
         : heatLoss(heatLoss)
     {
         for (unsigned int i=0; i < bestHistory.size(); i++) {
-            bestHistory[i] = std::numeric_limits<unsigned int>::max;
+            bestHistory[i] = std::numeric_limits<unsigned int>::max();
         }
     }
 
@@ -165,7 +162,7 @@ public:
 
     bool checkIfBetterCrucibleWasHereBefore(const Crucible & crucible) const {
         assert(crucible.getStepCount() < MAXIMUM_STRAIGHT_MOVES);
-        return bestHistory[crucible.getStepCount] < crucible.getHeatLoss();
+        return bestHistory[crucible.getStepCount()] < crucible.getHeatLoss();
     }
 
     //TODO: record move and put in bestHistory.
@@ -174,22 +171,24 @@ public:
 template<typename T>
 puzzleValueType solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // convert to map
-    std::vector<std::vector<Block>> map;
-    for (const auto & line : lines) {
-        std::vector<Block> mapLine;
-        for (const auto & c : line) {
+    const size_t width = lines.empty()? 0 : lines[0].size();
+    Grid<Block> map(width, lines.size(), Block(0));
+    for (size_t y=0; y < lines.size(); y++) {
+        for (size_t x=0; x < lines[y].size() && x < width; x++) {
+            const char & c = lines[y][x];
             assert(c >= '0' && c <= '9');
-            mapLine.emplace(c-'0');
+            map.at(x, y) = Block(c-'0');
         }
-        map.push_back(mapLine);
     }
 
+    Runner::markParsed();
+
     // TODO: add Crucibles from starting line.
 
     puzzleValueType puzzleValue = 0;
@@ -204,23 +203,36 @@ constexpr puzzleValueType expectedSolution_problem2 = -1;
 template<typename T>
 puzzleValueType solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
+    Runner::markParsed();
+
     puzzleValueType puzzleValue = 0;
 
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+// not solved yet, so there is nothing to expect
+const Runner::Registration registration(17, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, {},
+    {}, {});
+#endif
+
+}; // namespace day17
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day17;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -238,21 +250,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
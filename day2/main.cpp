@@ -1,15 +1,19 @@
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
+#include "ParallelUtils.hpp"
 #include "StringUtils.hpp"
+#include "Runner.hpp"
 
 #include <cassert>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+namespace day2 {
+
 // --- Day 2: Cube Conundrum ---
 // You're launched high into the atmosphere!
 // The apex of your trajectory just barely reaches the surface of a large island floating in the sky.
@@ -64,6 +68,8 @@ Game 3: 8 green, 6 blue, 20 red; 5 blue, 4 red, 13 green; 5 green, 1 red\n\
 Game 4: 1 green, 3 red, 6 blue; 3 green, 6 red; 3 green, 15 blue, 14 red\n\
 Game 5: 6 red, 1 blue, 3 green; 2 blue, 1 red, 2 green\n";
 
+constexpr int expectedSolution_problem1 = 8;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -75,16 +81,16 @@ private:
     std::vector<int> greenNumbers;
     std::vector<int> blueNumbers;
 public:
-    Game(const std::string & line) :
+    Game(std::string_view line) :
         gameNumber(processGameNumber(line)),
         redNumbers(processRedNumbers(line)),
         greenNumbers(processGreenNumbers(line)),
         blueNumbers(processBlueNumbers(line))
     {
-        std::cout << "Game[" << gameNumber << "]" << std::endl;
-        std::cout << CoutUtils::convertToString("red  ", redNumbers) << std::endl;
-        std::cout << CoutUtils::convertToString("green", greenNumbers) << std::endl;
-        std::cout << CoutUtils::convertToString("blue ", blueNumbers) << std::endl;
+        LOG(debug, "Game[" << gameNumber << "]");
+        LOG(debug, CoutUtils::convertToString("red  ", redNumbers));
+        LOG(debug, CoutUtils::convertToString("green", greenNumbers));
+        LOG(debug, CoutUtils::convertToString("blue ", blueNumbers));
         assert(redNumbers.size() == greenNumbers.size());
         assert(greenNumbers.size() == blueNumbers.size());
     }
@@ -103,30 +109,26 @@ public:
         return blueNumbers;
     }
 private:
-    int processGameNumber(const std::string & line) {
-        auto strings = StringUtils::split(line, ": ");
-        const std::string gamePart = strings[0];
-        const std::string numberPart = StringUtils::remove(gamePart, "Game ");
-        const int number = std::stoi(numberPart);
+    int processGameNumber(std::string_view line) {
+        const std::string_view gamePart = *StringUtils::splitView(line, ": ").begin();
+        const std::string_view numberPart = StringUtils::removePrefix(gamePart, "Game ");
+        const int number = StringUtils::toNumber<int>(numberPart);
         return number;
     }
 
-    std::vector<int> processColorNumbers(const std::string & line, const std::string & color) {
+    std::vector<int> processColorNumbers(std::string_view line, std::string_view color) {
         std::vector<int> ret;
-        auto subsections = StringUtils::split(line, ": ");
-        const std::string & gameData = subsections[1];
-        auto cubeDraws = StringUtils::split(gameData, "; ");
+        auto subsections = StringUtils::splitView(line, ": ");
+        const std::string_view gameData = *std::next(subsections.begin());
 
-        for (auto cubeDraw : cubeDraws) {
-            auto colorDraws = StringUtils::split(cubeDraw, ",");
+        for (std::string_view cubeDraw : StringUtils::splitView(gameData, "; ")) {
             bool found = false;
-            for (auto colorDraw : colorDraws) {
+            for (std::string_view colorDraw : StringUtils::splitView(cubeDraw, ",")) {
                 auto colorIndex = colorDraw.find(color);
-                if (colorIndex != std::string::npos) {
-                    // found the right color
+                if (colorIndex != std::string_view::npos) {
+                    // found the right color; the number precedes it.
                     found = true;
-                    const std::string colorDrawNumberStr = StringUtils::remove(colorDraw, color);
-                    const int colorDrawNumber = std::stoi(colorDrawNumberStr);
+                    const int colorDrawNumber = StringUtils::toNumber<int>(colorDraw.substr(0, colorIndex));
                     ret.push_back(colorDrawNumber);
                     break;
                 }
@@ -138,34 +140,35 @@ private:
         return ret;
     }
 
-    std::vector<int> processRedNumbers(const std::string & line) {
+    std::vector<int> processRedNumbers(std::string_view line) {
         return processColorNumbers(line, "red");
     }
-    std::vector<int> processGreenNumbers(const std::string & line) {
+    std::vector<int> processGreenNumbers(std::string_view line) {
         return processColorNumbers(line, "green");
     }
-    std::vector<int> processBlueNumbers(const std::string & line) {
+    std::vector<int> processBlueNumbers(std::string_view line) {
         return processColorNumbers(line, "blue");
     }
 };
 
 template<typename T>
-void solve1(T & stream) {
+int solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // Convert to game-data
-    std::vector<Game> games;
-    for (const auto & line : lines) {
-        games.emplace_back(line);
-    }
+    const std::vector<Game> games = ParallelUtils::parallelTransform(lines.size(), [&lines](size_t i) {
+        return Game(lines[i]);
+    });
+
+    Runner::markParsed();
 
-    // Collect possible games
-    std::vector<Game> possibleGames;
-    for (const auto & game : games) {
+    // Add up the game numbers of the possible games
+    int puzzleValue = ParallelUtils::parallelReduce(games.size(), 0, [&games](size_t i) {
+        const Game & game = games[i];
         int highestRedNumber = 0;
         int highestGreenNumber = 0;
         int highestBlueNumber = 0;
@@ -177,17 +180,13 @@ void solve1(T & stream) {
             && highestGreenNumber <= maximumGreenCubes 
             && highestBlueNumber <= maximumBlueCubes)
         {
-            possibleGames.push_back(game);
+            return game.getGameNumber();
         }
-    }
-
-    // Compute puzzle value
-    int puzzleValue = 0;
-    for (const auto & possibleGame : possibleGames) {
-        puzzleValue += possibleGame.getGameNumber();
-    }
+        return 0;
+    });
 
     std::cout << "solve1:[" << puzzleValue << "]" << std::endl;
+    return puzzleValue;
 }
 
 
@@ -225,24 +224,26 @@ void solve1(T & stream) {
 
 const std::string & givenTestData_problem2 = givenTestData_problem1;
 
+constexpr int expectedSolution_problem2 = 2286;
+
 template<typename T>
-void solve2(T & stream) {
+int solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // Convert to game-data
-    std::vector<Game> games;
-    for (const auto & line : lines) {
-        games.emplace_back(line);
-    }
+    const std::vector<Game> games = ParallelUtils::parallelTransform(lines.size(), [&lines](size_t i) {
+        return Game(lines[i]);
+    });
+
+    Runner::markParsed();
 
-    // Collect possible games
     // Compute puzzle value
-    int puzzleValue = 0;
-    for (const auto & game : games) {
+    int puzzleValue = ParallelUtils::parallelReduce(games.size(), 0, [&games](size_t i) {
+        const Game & game = games[i];
         int highestRedNumber = 0;
         int highestGreenNumber = 0;
         int highestBlueNumber = 0;
@@ -250,39 +251,50 @@ void solve2(T & stream) {
         NumberUtils::getHighestElement(game.getGreenNumbers(), highestGreenNumber);
         NumberUtils::getHighestElement(game.getBlueNumbers(), highestBlueNumber);
 
-        puzzleValue += highestRedNumber * highestGreenNumber * highestBlueNumber;
-    }
+        return highestRedNumber * highestGreenNumber * highestBlueNumber;
+    });
 
     std::cout << "solve2:[" << puzzleValue << "]" << std::endl;
+    return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(2, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
 
+}; // namespace day2
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day2;
+
     if (argc == 1) {
-        // std::stringstream strStream_problem1(givenTestData_problem1);
-        // solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        solve2(strStream_problem2);
+        // InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        // solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        solve2(testData_problem2);
     } else if (argc == 2 || argc == 3) {
         std::string url(argv[1]);
         std::cout << url << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (fileStream.is_open()) {
+        InputUtils::MappedFile file(path);
+        if (file.is_open()) {
             std::cout << "IsOpen" << std::endl;
         } else {
             std::cout << "Is NOT Open" << std::endl;
         }
+        InputUtils::LineReader fileInput(file);
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            solve1(fileStream);
+            solve1(fileInput);
         } else if(argc == 3 && argv[2][0] == 'B') {
-            solve2(fileStream);
+            solve2(fileInput);
             std::cout << "solve2" << std::endl;
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
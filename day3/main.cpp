@@ -1,18 +1,21 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
+#include "Runner.hpp"
 
 #include <cassert>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cctype>
 
+namespace day3 {
+
 // --- Day 3: Gear Ratios ---
 // You and the Elf eventually reach a gondola lift station;
 //  he says the gondola lift will take you up to the water source,
@@ -138,7 +141,7 @@ public:
     }
 };
 
-std::string collectDigits(const std::string & line, const int index) {
+std::string collectDigits(std::string_view line, const int index) {
     std::string ret;
     if (index >= line.size()) {
         return {};
@@ -153,7 +156,7 @@ std::string collectDigits(const std::string & line, const int index) {
     return ret;
 }
 
-std::vector<Number> parseLineForNumbers(const std::string & line, const int & row) {
+std::vector<Number> parseLineForNumbers(std::string_view line, const int & row) {
     std::vector<Number> ret;
 
     for (unsigned int i=0; i < line.size(); i++) {
@@ -176,7 +179,7 @@ std::vector<Number> parseLineForNumbers(const std::string & line, const int & ro
     return ret;
 }
 
-std::vector<Symbol> parseLineForSymbols(const std::string & line, const int & row) {
+std::vector<Symbol> parseLineForSymbols(std::string_view line, const int & row) {
     std::vector<Symbol> ret;
 
     for (unsigned int i=0; i < line.size(); i++) {
@@ -194,8 +197,8 @@ std::vector<Symbol> parseLineForSymbols(const std::string & line, const int & ro
 template<typename T>
 int solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
@@ -203,13 +206,15 @@ int solve1(T & stream) {
     std::vector<Number> numbers;
     std::vector<Symbol> symbols;
     for (unsigned int i=0; i < lines.size(); i++) {
-        const std::string & line = lines[i];
+        std::string_view line = lines[i];
         auto newNumbers = parseLineForNumbers(line, i);
         numbers = VectorUtils::concatenate(numbers, newNumbers);
         auto newSymbols = parseLineForSymbols(line, i);
         symbols = VectorUtils::concatenate(symbols, newSymbols);
     }
 
+    Runner::markParsed();
+
     // Find numbers with a symbol
     std::vector<Number> numbersWithSymbol;
     for (const Number & number : numbers) {
@@ -285,8 +290,8 @@ const std::string & givenTestData_problem2 = givenTestData_problem1;
 template<typename T>
 int solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
@@ -294,13 +299,15 @@ int solve2(T & stream) {
     std::vector<Number> numbers;
     std::vector<Symbol> symbols;
     for (unsigned int i=0; i < lines.size(); i++) {
-        const std::string & line = lines[i];
+        std::string_view line = lines[i];
         auto newNumbers = parseLineForNumbers(line, i);
         numbers = VectorUtils::concatenate(numbers, newNumbers);
         auto newSymbols = parseLineForSymbols(line, i);
         symbols = VectorUtils::concatenate(symbols, newSymbols);
     }
 
+    Runner::markParsed();
+
     // Find gears, calculate their gear ratio and sum it. Might need a bigger datatype than int for this?
     int puzzleResult = 0;
     for (const Symbol & symbol : symbols) {
@@ -326,14 +333,23 @@ int solve2(T & stream) {
     return puzzleResult;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(3, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
 
+}; // namespace day3
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day3;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -351,21 +367,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -1,19 +1,23 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
+#include "ParallelUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
+#include "Runner.hpp"
 
 #include <cassert>
 #include <cctype>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+namespace day4 {
+
 // --- Day 4: Scratchcards ---
 // The gondola takes you up.
 // Strangely, though, the ground doesn't seem to be coming with you; you're not climbing a mountain.
@@ -92,7 +96,7 @@ private:
     std::vector<int> playingNumbers;
 
 public:
-    Card(const std::string & line) :
+    Card(std::string_view line) :
         cardNumber(processCardNumber(line)),
         winningNumbers(processWinningNumbers(line)),
         playingNumbers(processPlayingNumbers(line))
@@ -110,46 +114,29 @@ public:
         return cardNumber;
     }
 private:
-    static int processCardNumber(const std::string & line) {
-        auto strings = StringUtils::split(line, ": ");
-        const std::string cardPart = strings[0];
-        const std::string numberPart = StringUtils::remove(cardPart, "Card ");
-        const int number = std::stoi(numberPart);
+    static int processCardNumber(std::string_view line) {
+        const std::string_view cardPart = *StringUtils::splitView(line, ": ").begin();
+        const std::string_view numberPart = StringUtils::removePrefix(cardPart, "Card ");
+        const int number = StringUtils::toNumber<int>(numberPart);
         return number;
     }
 
-    static std::vector<int> processWinningNumbers(const std::string & line) {
+    static std::vector<int> processNumbers(std::string_view numbersPart) {
         std::vector<int> ret;
-        auto cardStrings = StringUtils::split(line, ": ");
-        const std::string numbersPart = cardStrings[1];
-        auto numbersPartsStrings = StringUtils::split(numbersPart, " | ");
-        const std::string winningNumbersPart = numbersPartsStrings[0];
-        auto winningNumbersRaw = StringUtils::split(winningNumbersPart, " ");
-
-        auto winningNumbersVector = VectorUtils::remove(winningNumbersRaw, {""});
-
-        for (const auto & winningNumberStr : winningNumbersVector) {
-            ret.push_back(std::stoi(winningNumberStr));
-        }
-
+        NumberUtils::parseNumbers(numbersPart, ret);
         return ret;
     }
 
-    static std::vector<int> processPlayingNumbers(const std::string & line) {
-        std::vector<int> ret;
-        auto cardStrings = StringUtils::split(line, ": ");
-        const std::string numbersPart = cardStrings[1];
-        auto numbersPartsStrings = StringUtils::split(numbersPart, " | ");
-        const std::string playingNumbersPart = numbersPartsStrings[1];
-        auto playingNumbersRaw = StringUtils::split(playingNumbersPart, " ");
-
-        auto playingNumbersVector = VectorUtils::remove(playingNumbersRaw, {""});
-
-        for (const auto & playingNumberStr : playingNumbersVector) {
-            ret.push_back(std::stoi(playingNumberStr));
-        }
+    static std::vector<int> processWinningNumbers(std::string_view line) {
+        const std::string_view numbersPart = *std::next(StringUtils::splitView(line, ": ").begin());
+        const std::string_view winningNumbersPart = *StringUtils::splitView(numbersPart, " | ").begin();
+        return processNumbers(winningNumbersPart);
+    }
 
-        return ret;
+    static std::vector<int> processPlayingNumbers(std::string_view line) {
+        const std::string_view numbersPart = *std::next(StringUtils::splitView(line, ": ").begin());
+        const std::string_view playingNumbersPart = *std::next(StringUtils::splitView(numbersPart, " | ").begin());
+        return processNumbers(playingNumbersPart);
     }
 };
 
@@ -157,21 +144,21 @@ private:
 template<typename T>
 int solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // Parse cards
-    std::vector<Card> cards;
-    for (auto line : lines) {
-        cards.push_back(Card(line));
-    }
+    const std::vector<Card> cards = ParallelUtils::parallelTransform(lines.size(), [&lines](size_t i) {
+        return Card(lines[i]);
+    });
+
+    Runner::markParsed();
 
     // Count score
-    int puzzleValue = 0;
-    for (auto & card : cards) {
-        auto numbersIntersection = card.getIntersection();
+    int puzzleValue = ParallelUtils::parallelReduce(cards.size(), 0, [&cards](size_t i) {
+        auto numbersIntersection = cards[i].getIntersection();
         int numberOfMatches = numbersIntersection.size();
         int cardScore = 0;
         if (numberOfMatches > 0) {
@@ -183,8 +170,8 @@ int solve1(T & stream) {
             numberOfMatches--;
         }
 
-        puzzleValue += cardScore;
-    }
+        return cardScore;
+    });
 
     return puzzleValue;
 }
@@ -240,49 +227,54 @@ constexpr int expectedSolution_problem2 = 30;
 template<typename T>
 int solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // Parse cards
-    std::vector<Card> cards;
-    std::queue<Card> unprocessedCards;
-    int puzzleValue = 0;
-    for (auto line : lines) {
-        cards.push_back(Card(line));
-        unprocessedCards.push(Card(line));
-        puzzleValue++;
-    }
+    const std::vector<Card> cards = ParallelUtils::parallelTransform(lines.size(), [&lines](size_t i) {
+        return Card(lines[i]);
+    });
+
+    Runner::markParsed();
+
+    // The matches of a card don't depend on how many copies of it there are.
+    const std::vector<int> matches = ParallelUtils::parallelTransform(cards.size(), [&cards](size_t i) {
+        return static_cast<int>(cards[i].getIntersection().size());
+    });
 
-    // Calculate score
-    std::unordered_map<int, int> nrCards;
-    while (!unprocessedCards.empty()) {
-        const Card & unprocessedCard = unprocessedCards.front();
-        nrCards[unprocessedCard.getCardNumber()]++;
-        int matches = unprocessedCard.getIntersection().size();
-        std::cout << "Card[" << unprocessedCard.getCardNumber() << "] has [" << matches << "] matches." << std::endl;
-        for (int i=unprocessedCard.getCardNumber(); i < unprocessedCard.getCardNumber()+matches; i++) {
-            unprocessedCards.push(cards[i-1+1]);    //-1 to convert from CardNumber to index; +1 to get to next index (add the next card, not the one just processed).
-            puzzleValue++;
+    // Every copy of a card wins one copy of each of the next 'matches' cards; the cards before it are all settled by then.
+    std::vector<int> nrCards(cards.size(), 1);
+    int puzzleValue = 0;
+    for (size_t i=0; i < cards.size(); i++) {
+        LOG(debug, "Card[" << cards[i].getCardNumber() << "] has [" << matches[i] << "] matches, [" << nrCards[i] << "] copies.");
+        for (size_t i2=i+1; i2 <= i+matches[i] && i2 < cards.size(); i2++) {
+            nrCards[i2] += nrCards[i];
         }
-        unprocessedCards.pop();
+        puzzleValue += nrCards[i];
     }
 
-    // for (auto [cardNumber, score] : nrCards) {
-    //     std::cout << "cardNumber:[" << cardNumber << "] score:[" << score << "]" << std::endl;
-    // }
-
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(4, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
+
+}; // namespace day4
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day4;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -300,21 +292,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -1,20 +1,28 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
+#include "SymbolUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
 #include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+namespace day5 {
+
 
 // --- Day 5: If You Give A Seed A Fertilizer ---
 // You take the boat and find the gardener right where you were told he would be:
@@ -210,42 +218,26 @@ using puzzleValueType = long long int;
 constexpr puzzleValueType expectedSolution_problem1 = 35;
 
 
-class ObjectRange {
+// All values of one kind of object, e.g. every seed that gets planted.
+class ObjectRanges {
 private:
-    std::string objectName;
-    RangeUtils::Range<puzzleValueType> range;
-    // puzzleValueType valueStart;     //inclusive
-    // puzzleValueType valueEnd;   //inclusive
+    SymbolUtils::idType objectId;
+    RangeUtils::RangeSet<puzzleValueType> ranges;
 
 public:
-    ObjectRange(const std::string & objectName, puzzleValueType valueStart, puzzleValueType valueEnd) :
-        objectName(objectName),
-        range(valueStart, valueEnd)
-    {
-        //do nothing
-    }
-
-    ObjectRange(const std::string & objectName, const RangeUtils::Range<puzzleValueType> & range) :
-        objectName(objectName),
-        range(range)
+    ObjectRanges(SymbolUtils::idType objectId, const RangeUtils::RangeSet<puzzleValueType> & ranges) :
+        objectId(objectId),
+        ranges(ranges)
     {
         //do nothing
     }
 
-    const std::string & getObjectName() const {
-        return objectName;
-    }
-
-    puzzleValueType getValueStart() const {
-        return range.getStart();
-    }
-
-    puzzleValueType getValueEnd() const {
-        return range.getEnd();
+    SymbolUtils::idType getObjectId() const {
+        return objectId;
     }
 
-    RangeUtils::Range<puzzleValueType> getRange() const {
-        return range;
+    const RangeUtils::RangeSet<puzzleValueType> & getRanges() const {
+        return ranges;
     }
 };
 
@@ -259,11 +251,13 @@ private:
     // puzzleValueType source;
     // puzzleValueType range;
 public:
-    ConversionRange(const std::string & line) {
-        auto values = StringUtils::split(line, " ");
-        auto destination = std::stoll(values[0]);
-        auto source = std::stoll(values[1]);
-        auto range = std::stoll(values[2]);
+    ConversionRange(std::string_view line) {
+        puzzleValueType values[3];
+        [[maybe_unused]] auto valueCount = NumberUtils::parseNumbers(line, values, 3);
+        assert(valueCount == 3);
+        auto destination = values[0];
+        auto source = values[1];
+        auto range = values[2];
         destinationRange = RangeUtils::Range<puzzleValueType>(destination, destination + range-1);  //-1 to convert to inclusive end
         sourceRange = RangeUtils::Range<puzzleValueType>(source, source + range-1);  //-1 to convert to inclusive end
     }
@@ -273,7 +267,11 @@ public:
     }
 
     puzzleValueType convert(puzzleValueType sourceValue) const {
-        return sourceValue + (destinationRange.getStart()-sourceRange.getStart());
+        return sourceValue + getOffset();
+    }
+
+    puzzleValueType getOffset() const {
+        return destinationRange.getStart()-sourceRange.getStart();
     }
 
     puzzleValueType getStart() const {
@@ -287,59 +285,23 @@ public:
     RangeUtils::Range<puzzleValueType> getSourceRange() const {
         return sourceRange;
     }
-
-    void convert(const ObjectRange & objRange, const std::string & convertToObjectName, std::vector<ObjectRange> & convertedObjRanges, std::queue<ObjectRange> & unconvertedObjRanges) {
-        if (!RangeUtils::hasOverlap(objRange.getRange(), sourceRange)) {
-            // no overlap, nothing to process.
-            unconvertedObjRanges.push(objRange);
-            return;
-        }
-        //overlap exists; this needs processing
-        auto ranges = RangeUtils::shatter(objRange.getRange(), sourceRange);
-        for (auto & range : ranges) {
-            if (range.empty()) {
-                // no need to process empty ranges
-                continue;
-            }
-            //only process if range is from original objRange
-            if (!RangeUtils::isSubSet(range, objRange.getRange())) {
-                continue;
-            }
-            if (RangeUtils::hasOverlap(range, sourceRange)) {
-                // fits in conversion range; so convert
-                
-                convertedObjRanges.emplace_back(
-                    ObjectRange(
-                        convertToObjectName,
-                        RangeUtils::shift(
-                            range,
-                            (destinationRange.getStart()-sourceRange.getStart())
-                        )
-                    )
-                );
-            } else {
-                // does not fit in conversion range, so don't convert
-                unconvertedObjRanges.push(ObjectRange(objRange.getObjectName(), range));
-            }
-        }
-    }
 };
 
 class Object {
 private:
-    std::string objectName;
+    SymbolUtils::idType objectId;
     puzzleValueType value;
 
 public:
-    Object(const std::string & objectName, puzzleValueType value) :
-        objectName(objectName),
+    Object(SymbolUtils::idType objectId, puzzleValueType value) :
+        objectId(objectId),
         value(value)
     {
         //do nothing
     }
 
-    std::string getObjectName() const {
-        return objectName;
+    SymbolUtils::idType getObjectId() const {
+        return objectId;
     }
 
     puzzleValueType getValue() const {
@@ -349,134 +311,185 @@ public:
 
 class ConversionMap {
 private:
+    // From 'start' up to the next breakpoint, values are converted by adding 'offset'.
+    using Breakpoint = RangeUtils::Breakpoint<puzzleValueType>;
+
     std::vector<ConversionRange> conversions;
-    std::string fromObjectName;
-    std::string toObjectName;
+    std::vector<Breakpoint> breakpoints;    //sorted, the first one starts at the lowest value; see compile()
+    SymbolUtils::idType fromObjectId = 0;
+    SymbolUtils::idType toObjectId = 0;
 
 public:
     ConversionMap() {}
-
-    ConversionMap(const std::string & line) {
+    ConversionMap(std::string_view line, SymbolUtils::SymbolTable & objectNames) {
         // line ~= fertilizer-to-water map:
         assert(StringUtils::contains(line, " map:"));
-        auto line_temp1 = StringUtils::remove(line, " map:");
-        auto mapNames = StringUtils::split(line_temp1, "-to-");
-        fromObjectName = mapNames[0];
-        toObjectName = mapNames[1];
+        auto mapNames = StringUtils::splitView(line.substr(0, line.find(" map:")), "-to-").begin();
+        fromObjectId = objectNames.intern(*mapNames++);
+        toObjectId = objectNames.intern(*mapNames);
     }
 
     void addConversionRange(const ConversionRange & conversionRange) {
         conversions.push_back(conversionRange);
     }
 
-    Object convert(Object & obj) {
-        assert(obj.getObjectName() == fromObjectName);
-        const auto objectValue = obj.getValue();
-        for (auto & conversion : conversions) {
-            if (conversion.inRange(objectValue)) {
-                auto convertedValue = conversion.convert(objectValue);
-                // conversion found, convert and return
-                return Object(toObjectName, convertedValue);
-            }
+    // Turns the conversion ranges into breakpoints that cover every value, the gaps between them converting 1-to-1.
+    // Has to be called once all conversion ranges are added, before converting anything.
+    void compile() {
+        std::sort(conversions.begin(), conversions.end(), [](const ConversionRange & lhs, const ConversionRange & rhs) {
+            return lhs.getStart() < rhs.getStart();
+        });
+
+        breakpoints.clear();
+        breakpoints.push_back({std::numeric_limits<puzzleValueType>::min(), 0});
+        for (size_t i=0; i < conversions.size(); i++) {
+            assert(i == 0 || conversions[i].getStart() > conversions[i-1].getEnd());    //conversion ranges don't overlap
+            addBreakpoint(conversions[i].getStart(), conversions[i].getOffset());
+            addBreakpoint(conversions[i].getEnd() + 1, 0);
         }
-        // no conversion found; 1-to-1 conversion
-        return Object(toObjectName, objectValue);
     }
 
-    std::vector<ObjectRange> convert(ObjectRange & _objRange) {
-        assert(_objRange.getObjectName() == fromObjectName);
+    Object convert(const Object & obj) const {
+        assert(obj.getObjectId() == fromObjectId);
+        const auto objectValue = obj.getValue();
+        return Object(toObjectId, objectValue + findBreakpoint(objectValue)->offset);
+    }
 
-        std::vector<ObjectRange> ret;
-        std::queue<ObjectRange> unconvertedObjRanges;
-        unconvertedObjRanges.push(_objRange);
+    ObjectRanges convert(const ObjectRanges & objRanges) const {
+        assert(objRanges.getObjectId() == fromObjectId);
+        return ObjectRanges(toObjectId, RangeUtils::applyOffsets(objRanges.getRanges(), breakpoints));
+    }
 
-        for (auto conversion : conversions) {
-            std::queue<ObjectRange> nextUnconvertedObjRanges;
-            while (!unconvertedObjRanges.empty()) {
-                auto & objRange = unconvertedObjRanges.front();
-                unconvertedObjRanges.pop();
-                conversion.convert(objRange, toObjectName, ret, nextUnconvertedObjRanges);
+    // The same as convert(), straight from the conversion ranges with set operations; slower, only to cross-check the breakpoints.
+    ObjectRanges convertBySetOperations(const ObjectRanges & objRanges) const {
+        assert(objRanges.getObjectId() == fromObjectId);
+        RangeUtils::RangeSet<puzzleValueType> converted;
+        RangeUtils::RangeSet<puzzleValueType> sources;
+        for (const auto & conversion : conversions) {
+            const RangeUtils::RangeSet<puzzleValueType> source = {conversion.getSourceRange()};
+            converted = RangeUtils::unite(converted, RangeUtils::shift(RangeUtils::intersect(objRanges.getRanges(), source), conversion.getOffset()));
+            sources = RangeUtils::unite(sources, source);
+        }
+        return ObjectRanges(toObjectId, RangeUtils::unite(converted, RangeUtils::difference(objRanges.getRanges(), sources)));
+    }
+
+    // This map followed by 'next' as one map: every piece between two breakpoints of this map
+    //  is split wherever its converted values cross a breakpoint of 'next'.
+    ConversionMap then(const ConversionMap & next) const {
+        assert(toObjectId == next.fromObjectId);
+        assert(!breakpoints.empty() && !next.breakpoints.empty());
+        ConversionMap ret;
+        ret.fromObjectId = fromObjectId;
+        ret.toObjectId = next.toObjectId;
+        ret.breakpoints.push_back({std::numeric_limits<puzzleValueType>::min(), 0});
+        for (size_t i=0; i < breakpoints.size(); i++) {
+            const auto & [start, offset] = breakpoints[i];  //the lowest and the highest piece have offset 0, so none of this overflows
+            auto nextBreakpoint = next.findBreakpoint(start + offset);
+            ret.addBreakpoint(start, offset + nextBreakpoint->offset);
+            for (nextBreakpoint++; nextBreakpoint != next.breakpoints.end(); nextBreakpoint++) {
+                const puzzleValueType nextStart = nextBreakpoint->start - offset;
+                if (i+1 < breakpoints.size() && nextStart >= breakpoints[i+1].start) {
+                    break;
+                }
+                ret.addBreakpoint(nextStart, offset + nextBreakpoint->offset);
             }
-            unconvertedObjRanges = nextUnconvertedObjRanges;
         }
+        return ret;
+    }
 
-        while (!unconvertedObjRanges.empty()) {
-            auto & objRange = unconvertedObjRanges.front();
-            unconvertedObjRanges.pop();
+    SymbolUtils::idType getFromObjectId() const {
+        return fromObjectId;
+    }
 
-            ret.emplace_back(
-                ObjectRange(
-                    toObjectName,
-                    objRange.getRange()
-                )
-            );
-        }
+    SymbolUtils::idType getToObjectId() const {
+        return toObjectId;
+    }
 
-        return ret;
+private:
+    // The breakpoint whose piece holds value.
+    std::vector<Breakpoint>::const_iterator findBreakpoint(puzzleValueType value) const {
+        assert(!breakpoints.empty());
+        auto breakpoint = std::upper_bound(breakpoints.begin(), breakpoints.end(), value, [](puzzleValueType value, const Breakpoint & breakpoint) {
+            return value < breakpoint.start;
+        });
+        return std::prev(breakpoint);
     }
 
-    const std::string & getFromObjectName() const {
-        return fromObjectName;
+    void addBreakpoint(puzzleValueType start, puzzleValueType offset) {
+        if (breakpoints.back().start == start) {
+            breakpoints.back().offset = offset;     //the previous conversion ends right where this one starts
+        } else if (breakpoints.back().offset != offset) {
+            breakpoints.push_back({start, offset});
+        }
     }
 };
 
+const std::string seedString = "seed";
+
+// The conversion maps, indexed by the ID of the object they convert from; not every object has one.
+using ConversionMaps = std::vector<std::optional<ConversionMap>>;
+
+// All conversion maps from 'objectId' onwards as one map, e.g. from seed straight to location.
+ConversionMap composeConversionMaps(const ConversionMaps & conversionMaps, SymbolUtils::idType objectId) {
+    assert(objectId < conversionMaps.size() && conversionMaps[objectId]);
+    ConversionMap ret = *conversionMaps[objectId];
+    while (ret.getToObjectId() < conversionMaps.size() && conversionMaps[ret.getToObjectId()]) {
+        ret = ret.then(*conversionMaps[ret.getToObjectId()]);
+    }
+    return ret;
+}
+
 template<typename T>
 puzzleValueType solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // Collect information
-    std::unordered_map<std::string, ConversionMap> conversionMaps;
+    SymbolUtils::SymbolTable objectNames;
+    const SymbolUtils::idType seedId = objectNames.intern(seedString);
+    ConversionMaps conversionMaps;
     std::vector<Object> objects;
-    std::string _lastConversionMapKey = "";
+    std::optional<SymbolUtils::idType> _lastConversionMapId;
     bool collectingSeeds = false;
     for (const auto & line : lines) {
         if (StringUtils::contains(line, " map:")) {
             // conversion map
-            ConversionMap map(line);
-            conversionMaps[map.getFromObjectName()] = map;
-            _lastConversionMapKey = map.getFromObjectName();
+            ConversionMap map(line, objectNames);
+            conversionMaps.resize(objectNames.size());
+            _lastConversionMapId = map.getFromObjectId();
+            conversionMaps[*_lastConversionMapId] = map;
         } else if (StringUtils::contains(line, "seeds:")) {
-            auto tempLine1 = StringUtils::remove(line, "seeds: ");
-            auto seedNumbers = StringUtils::split(tempLine1, " ");
+            std::vector<puzzleValueType> seedNumbers;
+            NumberUtils::parseNumbers(StringUtils::removePrefix(line, "seeds:"), seedNumbers);
             for (auto seedNumber : seedNumbers) {
-                objects.push_back(Object("seed", std::stoll(seedNumber)));
+                objects.push_back(Object(seedId, seedNumber));
             }
         } else if (!line.empty()) {
-            assert(!_lastConversionMapKey.empty());
-            conversionMaps[_lastConversionMapKey].addConversionRange(ConversionRange(line));
+            assert(_lastConversionMapId);
+            conversionMaps[*_lastConversionMapId]->addConversionRange(ConversionRange(line));
         }
     }
+    for (auto & conversionMap : conversionMaps) {
+        if (conversionMap) {
+            conversionMap->compile();
+        }
+    }
+
+    Runner::markParsed();
 
     assert(!conversionMaps.empty());
 
     // Process objects
-    std::vector<Object> finishedObjects;    //for when no more steps can be done
-    bool change = false;
-    do {
-        change = false;
-        std::vector<Object> newObjects;
-        for (auto object : objects) {
-            if (conversionMaps.contains(object.getObjectName())) {
-                Object newObject = conversionMaps[object.getObjectName()].convert(object);
-                newObjects.push_back(newObject);
-                change = true;
-            } else {
-                finishedObjects.push_back(object);
-            }
-        }
-        objects = newObjects;
-    } while (change);
-
-    assert(!finishedObjects.empty());
+    const ConversionMap seedToLocation = composeConversionMaps(conversionMaps, seedId);
+    assert(!objects.empty());
 
     // Get lowest value
-    puzzleValueType puzzleValue = finishedObjects[0].getValue();
-    for (auto object : finishedObjects) {
-        puzzleValue = std::min(puzzleValue, object.getValue());
+    puzzleValueType puzzleValue = std::numeric_limits<puzzleValueType>::max();
+    for (const auto & object : objects) {
+        puzzleValue = std::min(puzzleValue, seedToLocation.convert(object).getValue());
     }
 
     return puzzleValue;
@@ -509,102 +522,95 @@ puzzleValueType solve1(T & stream) {
 const std::string & givenTestData_problem2 = givenTestData_problem1;
 constexpr puzzleValueType expectedSolution_problem2 = 46;
 
-const std::string seedString = "seed";
-
 template<typename T>
 puzzleValueType solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // Collect information
-    std::unordered_map<std::string, ConversionMap> conversionMaps;
-    std::vector<ObjectRange> objectRanges;
-    std::string _lastConversionMapKey = "";
+    SymbolUtils::SymbolTable objectNames;
+    const SymbolUtils::idType seedId = objectNames.intern(seedString);
+    ConversionMaps conversionMaps;
+    std::vector<RangeUtils::Range<puzzleValueType>> seedRanges;
+    std::optional<SymbolUtils::idType> _lastConversionMapId;
     bool collectingSeeds = false;
     for (const auto & line : lines) {
         if (StringUtils::contains(line, " map:")) {
             // conversion map
-            ConversionMap map(line);
-            conversionMaps[map.getFromObjectName()] = map;
-            _lastConversionMapKey = map.getFromObjectName();
+            ConversionMap map(line, objectNames);
+            conversionMaps.resize(objectNames.size());
+            _lastConversionMapId = map.getFromObjectId();
+            conversionMaps[*_lastConversionMapId] = map;
         } else if (StringUtils::contains(line, "seeds:")) {
-            auto tempLine1 = StringUtils::remove(line, "seeds: ");
-            auto seedNumbers = StringUtils::split(tempLine1, " ");
+            std::vector<puzzleValueType> seedNumbers;
+            NumberUtils::parseNumbers(StringUtils::removePrefix(line, "seeds:"), seedNumbers);
             // process in two's
             assert((seedNumbers.size() & 1) == 0);  //is even
 
             for (unsigned int i=0; i < seedNumbers.size(); i+=2) {
-                auto & seedNumberStartStr = seedNumbers[i];
-                auto & seedNumberRangeStr = seedNumbers[i+1];
-                puzzleValueType seedNumberStart = std::stoll(seedNumberStartStr);
-                puzzleValueType seedNumberRange = std::stoll(seedNumberRangeStr);
+                puzzleValueType seedNumberStart = seedNumbers[i];
+                puzzleValueType seedNumberRange = seedNumbers[i+1];
 
-                objectRanges.emplace_back(ObjectRange(seedString, seedNumberStart, seedNumberStart+seedNumberRange-1));
+                seedRanges.emplace_back(seedNumberStart, seedNumberStart+seedNumberRange-1);
             }
         } else if (!line.empty()) {
-            assert(!_lastConversionMapKey.empty());
-            conversionMaps[_lastConversionMapKey].addConversionRange(ConversionRange(line));
+            assert(_lastConversionMapId);
+            conversionMaps[*_lastConversionMapId]->addConversionRange(ConversionRange(line));
         }
     }
-
-    assert(!conversionMaps.empty());
-
-    // Process objects
-    std::vector<ObjectRange> finishedObjectRanges;    //for when no more steps can be done
-    std::string lastObjectName = "";
-    bool change = false;
-    do {
-        std::cout << objectRanges[0].getObjectName() << ": ";
-        for (auto objectRange : objectRanges) {
-            std::cout << objectRange.getRange().toString();
-        }
-        std::cout << std::endl;
-
-        change = false;
-        std::vector<ObjectRange> newObjectRanges;
-        for (auto objectRange : objectRanges) {
-            // A print statement to keep me up to date and in the loop
-            if (objectRange.getObjectName() != lastObjectName) {
-                lastObjectName = objectRange.getObjectName();
-            }
-
-            // A print statement to keep me up to date and in the loop
-            if (conversionMaps.contains(objectRange.getObjectName())) {
-                auto justConvertedObjectRanges = conversionMaps[objectRange.getObjectName()].convert(objectRange);
-                newObjectRanges = VectorUtils::concatenate(newObjectRanges, justConvertedObjectRanges);
-                change = true;
-            } else {
-                finishedObjectRanges.emplace_back(objectRange);
-            }
+    for (auto & conversionMap : conversionMaps) {
+        if (conversionMap) {
+            conversionMap->compile();
         }
-        std::swap(objectRanges, newObjectRanges);
+    }
 
-        
-    } while (change);
+    Runner::markParsed();
 
-    assert(!finishedObjectRanges.empty());
+    assert(!conversionMaps.empty());
 
-    // Get lowest value
-    puzzleValueType puzzleValue = finishedObjectRanges[0].getValueStart();
-    for (auto finishedObjectRange : finishedObjectRanges) {
-        puzzleValue = std::min(puzzleValue, finishedObjectRange.getValueStart());
+    // Process objects
+    const ConversionMap seedToLocation = composeConversionMaps(conversionMaps, seedId);
+    const ObjectRanges seeds(seedId, RangeUtils::RangeSet<puzzleValueType>(seedRanges));
+    const ObjectRanges locations = seedToLocation.convert(seeds);
+    LOG(trace, objectNames.getName(seeds.getObjectId()) << ": " << seeds.getRanges().toString());
+    LOG(trace, objectNames.getName(locations.getObjectId()) << ": " << locations.getRanges().toString());
+    assert(!locations.getRanges().empty());
+
+#ifndef NDEBUG
+    // Cross-check the composed breakpoints by converting one map at a time with set operations instead.
+    ObjectRanges objects = seeds;
+    while (objects.getObjectId() < conversionMaps.size() && conversionMaps[objects.getObjectId()]) {
+        objects = conversionMaps[objects.getObjectId()]->convertBySetOperations(objects);
     }
+    assert(objects.getObjectId() == locations.getObjectId() && objects.getRanges() == locations.getRanges());
+#endif
 
-    //TODO: continue here; conversion is wrong. First step, from seed to soil seems wrong already.
+    // Get lowest value
+    puzzleValueType puzzleValue = locations.getRanges().front().getStart();
 
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(5, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
+
+}; // namespace day5
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day5;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -622,21 +628,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
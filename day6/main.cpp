@@ -1,20 +1,23 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
 #include <cassert>
 #include <cctype>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+namespace day6 {
+
 // --- Day 6: Wait For It ---
 // The ferry quickly brings you across Island Island.
 // After asking around, you discover that there is indeed normally a large pile of sand somewhere near here,
@@ -114,7 +117,7 @@ public:
                 ret++;
             }
         }
-        std::cout << "calculateSlow:[" << ret << "]" << std::endl;
+        LOG(debug, "calculateSlow:[" << ret << "]");
         return ret;
     }
 };
@@ -123,8 +126,8 @@ public:
 template<typename T>
 puzzleValueType solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
@@ -132,24 +135,10 @@ puzzleValueType solve1(T & stream) {
     std::vector<puzzleValueType> distances;
     for (auto & line : lines) {
         if (StringUtils::contains(line, "Time:")) {
-            std::string lineCleaned = StringUtils::remove(line, "Time:");
-            auto values = StringUtils::split(lineCleaned, " ");
-            for (auto & value : values) {
-                if (!value.empty()) {
-                    std::cout << "value:[" << value << "]" << std::endl;
-                    times.push_back(std::stoll(value));
-                }
-            }
+            NumberUtils::parseNumbers(StringUtils::removePrefix(line, "Time:"), times);
         }
         if (StringUtils::contains(line, "Distance:")) {
-            std::string lineCleaned = StringUtils::remove(line, "Distance:");
-            auto values = StringUtils::split(lineCleaned, " ");
-            for (auto & value : values) {
-                if (!value.empty()) {
-                    std::cout << "value:[" << value << "]" << std::endl;
-                    distances.push_back(std::stoll(value));
-                }
-            }
+            NumberUtils::parseNumbers(StringUtils::removePrefix(line, "Distance:"), distances);
         }
     }
 
@@ -161,6 +150,8 @@ puzzleValueType solve1(T & stream) {
         races.push_back(Race(times[i], distances[i]));
     }
 
+    Runner::markParsed();
+
     puzzleValueType puzzleValue = 1;
     for(auto & race : races) {
         auto marginValue = race.calculateSlow();
@@ -198,8 +189,8 @@ constexpr puzzleValueType expectedSolution_problem2 = 71503;
 template<typename T>
 puzzleValueType solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
@@ -207,26 +198,14 @@ puzzleValueType solve2(T & stream) {
     std::vector<puzzleValueType> distances;
     for (auto & line : lines) {
         if (StringUtils::contains(line, "Time:")) {
-            std::string lineCleaned = StringUtils::remove(line, "Time:");
-            lineCleaned = StringUtils::remove(lineCleaned, " ");
-            auto values = StringUtils::split(lineCleaned, " ");
-            for (auto & value : values) {
-                if (!value.empty()) {
-                    std::cout << "value:[" << value << "]" << std::endl;
-                    times.push_back(std::stoll(value));
-                }
-            }
+            // bad kerning; the spaces aren't separators, so it's a single number
+            const std::string lineCleaned = StringUtils::remove(StringUtils::removePrefix(line, "Time:"), " ");
+            NumberUtils::parseNumbers(lineCleaned, times);
         }
         if (StringUtils::contains(line, "Distance:")) {
-            std::string lineCleaned = StringUtils::remove(line, "Distance:");
-            lineCleaned = StringUtils::remove(lineCleaned, " ");
-            auto values = StringUtils::split(lineCleaned, " ");
-            for (auto & value : values) {
-                if (!value.empty()) {
-                    std::cout << "value:[" << value << "]" << std::endl;
-                    distances.push_back(std::stoll(value));
-                }
-            }
+            // bad kerning; the spaces aren't separators, so it's a single number
+            const std::string lineCleaned = StringUtils::remove(StringUtils::removePrefix(line, "Distance:"), " ");
+            NumberUtils::parseNumbers(lineCleaned, distances);
         }
     }
 
@@ -238,6 +217,8 @@ puzzleValueType solve2(T & stream) {
         races.push_back(Race(times[i], distances[i]));
     }
 
+    Runner::markParsed();
+
     puzzleValueType puzzleValue = 1;
     for(auto & race : races) {
         auto marginValue = race.calculateSlow();
@@ -249,13 +230,23 @@ puzzleValueType solve2(T & stream) {
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(6, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
+
+}; // namespace day6
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day6;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -273,21 +264,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
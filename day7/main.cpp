@@ -1,21 +1,26 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
+#include "ParallelUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 
+namespace day7 {
+
 // --- Day 7: Camel Cards ---
 // Your all-expenses-paid trip turns out to be a one-way, five-minute ride in an airship.
 // (At least it's a cool airship!)
@@ -142,7 +147,7 @@ private:
     puzzleValueType bid;
 
 public:
-    Hand(const std::string & str){
+    Hand(std::string_view str){
         auto strs = StringUtils::split(str, " ");
         cards = strs[0];
         bid = std::stoll(strs[1]);
@@ -168,10 +173,12 @@ public:
     }
 
     void print() const {
-        std::cout << "Hand" << std::endl;
-        std::cout << "cards:[" << cards << "]" << std::endl;
-        computeHandType(cards);
-        std::cout << "bid:[" << bid << "]" << std::endl;
+        LOG(trace, "Hand");
+        LOG(trace, "cards:[" << cards << "]");
+        if constexpr (CoutUtils::isLogging(CoutUtils::e_trace)) {
+            computeHandType(cards);     //logs the hand type
+        }
+        LOG(trace, "bid:[" << bid << "]");
     }
 
 private:
@@ -182,15 +189,15 @@ private:
         }
 
         if (cardDivision.size()==1) {
-            std::cout << "handType:[" << "fiveOfAKind" << "]" << std::endl;
+            LOG(trace, "handType:[" << "fiveOfAKind" << "]");
             return HandType_e::fiveOfAKind;
         }
         if (cardDivision.size()==2) {
             if ((cardDivision.begin()->second == 4) || (cardDivision.begin()->second == 1)) {
-                std::cout << "handType:[" << "fourOfAKind" << "]" << std::endl;
+                LOG(trace, "handType:[" << "fourOfAKind" << "]");
                 return HandType_e::fourOfAKind;
             } else {
-                std::cout << "handType:[" << "fullHouse" << "]" << std::endl;
+                LOG(trace, "handType:[" << "fullHouse" << "]");
                 return HandType_e::fullHouse;
             }
         }
@@ -203,19 +210,19 @@ private:
             }
         }
         if (highestCount == 3) {
-            std::cout << "handType:[" << "threeOfAKind" << "]" << std::endl;
+            LOG(trace, "handType:[" << "threeOfAKind" << "]");
             return HandType_e::threeOfAKind;
         }
         if (pairCount == 2) {
-            std::cout << "handType:[" << "twoPair" << "]" << std::endl;
+            LOG(trace, "handType:[" << "twoPair" << "]");
             return HandType_e::twoPair;
         }
         if (pairCount == 1) {
-            std::cout << "handType:[" << "onePair" << "]" << std::endl;
+            LOG(trace, "handType:[" << "onePair" << "]");
             return HandType_e::onePair;
         }
 
-        std::cout << "handType:[" << "highcard" << "]" << std::endl;
+        LOG(trace, "handType:[" << "highcard" << "]");
         return HandType_e::highCard;
     }
 };
@@ -224,26 +231,27 @@ private:
 template<typename T>
 puzzleValueType solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
-    // convert to hands; and put in ordered set
-    std::set<Hand> hands;
-    for (auto & line : lines) {
-        Hand hand(line);
-        hands.insert(hand);
-    }
+    // convert to hands (working out their types), then order them
+    std::vector<Hand> hands = ParallelUtils::parallelTransform(lines.size(), [&lines](size_t i) {
+        return Hand(lines[i]);
+    });
+    std::sort(hands.begin(), hands.end());
 
-    std::cout << "---" << std::endl;
+    Runner::markParsed();
+
+    LOG(debug, "---");
     // compute value
     puzzleValueType puzzleValue = 0;
     int rank = 1;
     for (const Hand & hand : hands) {
         hand.print();
         puzzleValue += hand.getBid() * rank;
-        std::cout << hand.getBid() << " * " << rank << std::endl;
+        LOG(trace, hand.getBid() << " * " << rank);
         rank++;
     }
 
@@ -305,7 +313,7 @@ private:
     puzzleValueType bid;
 
 public:
-    Hand2(const std::string & str){
+    Hand2(std::string_view str){
         auto strs = StringUtils::split(str, " ");
         cards = strs[0];
         bid = std::stoll(strs[1]);
@@ -331,10 +339,12 @@ public:
     }
 
     void print() const {
-        std::cout << "Hand" << std::endl;
-        std::cout << "cards:[" << cards << "]" << std::endl;
-        computeHandType(cards);
-        std::cout << "bid:[" << bid << "]" << std::endl;
+        LOG(trace, "Hand");
+        LOG(trace, "cards:[" << cards << "]");
+        if constexpr (CoutUtils::isLogging(CoutUtils::e_trace)) {
+            computeHandType(cards);     //logs the hand type
+        }
+        LOG(trace, "bid:[" << bid << "]");
     }
 
 private:
@@ -345,15 +355,15 @@ private:
         }
 
         if (cardDivision.size()==1) {
-            std::cout << "handType:[" << "fiveOfAKind" << "]" << std::endl;
+            LOG(trace, "handType:[" << "fiveOfAKind" << "]");
             return HandType_e::fiveOfAKind;
         }
         if (cardDivision.size()==2) {
             if ((cardDivision.begin()->second == 4) || (cardDivision.begin()->second == 1)) {
-                std::cout << "handType:[" << "fourOfAKind" << "]" << std::endl;
+                LOG(trace, "handType:[" << "fourOfAKind" << "]");
                 return HandType_e::fourOfAKind;
             } else {
-                std::cout << "handType:[" << "fullHouse" << "]" << std::endl;
+                LOG(trace, "handType:[" << "fullHouse" << "]");
                 return HandType_e::fullHouse;
             }
         }
@@ -366,19 +376,19 @@ private:
             }
         }
         if (highestCount == 3) {
-            std::cout << "handType:[" << "threeOfAKind" << "]" << std::endl;
+            LOG(trace, "handType:[" << "threeOfAKind" << "]");
             return HandType_e::threeOfAKind;
         }
         if (pairCount == 2) {
-            std::cout << "handType:[" << "twoPair" << "]" << std::endl;
+            LOG(trace, "handType:[" << "twoPair" << "]");
             return HandType_e::twoPair;
         }
         if (pairCount == 1) {
-            std::cout << "handType:[" << "onePair" << "]" << std::endl;
+            LOG(trace, "handType:[" << "onePair" << "]");
             return HandType_e::onePair;
         }
 
-        std::cout << "handType:[" << "highcard" << "]" << std::endl;
+        LOG(trace, "handType:[" << "highcard" << "]");
         return HandType_e::highCard;
     }
 
@@ -414,39 +424,50 @@ private:
 template<typename T>
 puzzleValueType solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
-    // convert to hands; and put in ordered set
-    std::set<Hand2> hands;
-    for (auto & line : lines) {
-        Hand2 hand(line);
-        hands.insert(hand);
-    }
+    // convert to hands (working out their types), then order them
+    std::vector<Hand2> hands = ParallelUtils::parallelTransform(lines.size(), [&lines](size_t i) {
+        return Hand2(lines[i]);
+    });
+    std::sort(hands.begin(), hands.end());
+
+    Runner::markParsed();
 
-    std::cout << "---" << std::endl;
+    LOG(debug, "---");
     // compute value
     puzzleValueType puzzleValue = 0;
     int rank = 1;
     for (const auto & hand : hands) {
         hand.print();
         puzzleValue += hand.getBid() * rank;
-        std::cout << hand.getBid() << " * " << rank << std::endl;
+        LOG(trace, hand.getBid() << " * " << rank);
         rank++;
     }
 
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(7, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
+
+}; // namespace day7
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day7;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -464,21 +485,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
@@ -1,20 +1,25 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <queue>
-#include <sstream>
+#include <limits>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <set>
+
+namespace day8 {
 
 // --- Day 8: Haunted Wasteland ---
 // You're still riding a camel across Desert Island when you spot a sandstorm quickly approaching.
@@ -76,145 +81,140 @@ using puzzleValueType = long long int;
 constexpr puzzleValueType expectedSolution_problem1 = 6;
 
 
-enum direction_e {
+enum leftRight_e {
     Left,
     Right
 };
 
-class AvailableMove {
-private:
-    std::vector<direction_e> leftRightDirections;
+// Node labels are three characters, each one of 37 symbols: A-Z take 0-25, the digits 0-9 (used by the examples) take 26-35,
+//  and any other character maps to INVALID_SYMBOL, so a malformed label still stays inside the flat arrays.
+// The whole label is a three digit base 37 number below 37^3 = 50653; it fits in 16 bits and can index flat arrays directly.
+using nodeId = uint16_t;
+constexpr nodeId SYMBOL_COUNT = 37;
+constexpr nodeId INVALID_SYMBOL = SYMBOL_COUNT - 1;
+constexpr size_t NODE_COUNT = SYMBOL_COUNT * SYMBOL_COUNT * SYMBOL_COUNT;
 
-public:
-    AvailableMove(const std::string & line) {
-        std::cout << "AvailableMove:[";
-        for (const auto & c : line) {
-            assert (c == 'L' || c == 'R');
-            leftRightDirections.push_back( (c=='L')? Left : Right);
-            std::cout << c;
-        }
-        std::cout << "]" << std::endl;
+constexpr nodeId encodeSymbol(char c) {
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A';
     }
-
-    const std::vector<direction_e> & getLeftRightDirections() const {
-        return leftRightDirections;
+    if (c >= '0' && c <= '9') {
+        return 26 + (c - '0');
     }
-};
+    assert(false);
+    return INVALID_SYMBOL;
+}
 
-class Node {
-private:
-    std::string node;
-    std::string left;
-    Node * leftNode = nullptr;
-    std::string right;
-    Node * rightNode = nullptr;
-    bool finalNode = false;
-public:
-    Node(const std::string & line) {
-        std::string t1 = StringUtils::remove(line, "(");
-        t1 = StringUtils::remove(t1, ")");
-        t1 = StringUtils::remove(t1, "= ");
-        t1 = StringUtils::remove(t1, ",");
-        auto nodeStrings = StringUtils::split(t1, " ");
-        node = nodeStrings[0];
-        left = nodeStrings[1];
-        right = nodeStrings[2];
-        std::cout << "line:[" << line << "]" << std::endl;
-        std::cout << "t1:[" << t1 << "]" << std::endl;
-        assert(!node.empty());
-        assert(!left.empty());
-        assert(!right.empty());
+constexpr nodeId encodeNode(std::string_view name) {
+    assert(name.size() == 3);
+    if (name.size() != 3) {
+        return NODE_COUNT - 1;  //all three symbols invalid
     }
+    return (encodeSymbol(name[0]) * SYMBOL_COUNT + encodeSymbol(name[1])) * SYMBOL_COUNT + encodeSymbol(name[2]);
+}
 
-    const std::string & getNodeName() const {
-        return node;
+constexpr char decodeSymbol(nodeId symbol) {
+    if (symbol == INVALID_SYMBOL) {
+        return '?';
     }
+    return (symbol < 26)? 'A' + symbol : '0' + (symbol - 26);
+}
+
+inline std::string decodeNode(nodeId node) {
+    return {decodeSymbol(node / (SYMBOL_COUNT * SYMBOL_COUNT)), decodeSymbol(node / SYMBOL_COUNT % SYMBOL_COUNT), decodeSymbol(node % SYMBOL_COUNT)};
+}
+
+constexpr bool endsWith(nodeId node, char c) {
+    return node % SYMBOL_COUNT == encodeSymbol(c);
+}
+
+// The left/right instructions as one bit per step (set for Right), repeated forever.
+class Instructions {
+private:
+    std::vector<uint64_t> bits;
+    size_t length = 0;
 
-    const std::string & getLeftNodeString() const {
-        return left;
+public:
+    Instructions(std::string_view line) : bits((line.size() + 63) / 64, 0), length(line.size()) {
+        for (size_t i=0; i < line.size(); i++) {
+            assert (line[i] == 'L' || line[i] == 'R');
+            bits[i / 64] |= static_cast<uint64_t>(line[i] == 'R') << (i % 64);
+        }
+        assert(length > 0);
     }
 
-    const std::string & getRightNodeString() const {
-        return right;
+    size_t size() const {
+        return length;
     }
 
-    Node * getLeftNode() const {
-        return leftNode;
+    // index must be below size(), wrap it with next()
+    leftRight_e get(size_t index) const {
+        return static_cast<leftRight_e>((bits[index / 64] >> (index % 64)) & 1);
     }
 
-    Node * getRightNode() const {
-        return rightNode;
+    size_t next(size_t index) const {
+        return (++index == length)? 0 : index;
     }
+};
+
+// The left and right successor of every node, indexed by the encoded label.
+class Network {
+private:
+    std::vector<nodeId> successors[2] = {std::vector<nodeId>(NODE_COUNT), std::vector<nodeId>(NODE_COUNT)};
+    std::vector<nodeId> nodes;      //in input order
+    std::vector<nodeId> indices = std::vector<nodeId>(NODE_COUNT);  //node -> index in nodes
 
-    void setLeftNode(Node * leftNode) {
-        this->leftNode = leftNode;
+public:
+    // line ~= AAA = (BBB, CCC)
+    void addNode(std::string_view line) {
+        assert(line.size() == 16);
+        const nodeId node = encodeNode(line.substr(0, 3));
+        successors[Left][node] = encodeNode(line.substr(7, 3));
+        successors[Right][node] = encodeNode(line.substr(12, 3));
+        indices[node] = nodes.size();
+        nodes.push_back(node);
+        LOG(trace, "line:[" << line << "] node:[" << node << "]");
     }
 
-    void setRightNode(Node * rightNode) {
-        this->rightNode = rightNode;
+    nodeId step(nodeId node, leftRight_e direction) const {
+        return successors[direction][node];
     }
 
-    void setFinalNode() {
-        this->finalNode = true;
+    const std::vector<nodeId> & getNodes() const {
+        return nodes;
     }
 
-    bool isFinalNode() const {
-        return finalNode;
+    // Node indices are dense, so per node tables only need getNodes().size() entries.
+    nodeId getIndex(nodeId node) const {
+        return indices[node];
     }
 };
 
 template<typename T>
 puzzleValueType solve1(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
-    }
-
-    // Parse to data types
-    AvailableMove move(lines[0]);
-    std::unordered_map<std::string, Node*> nodes;
-    std::vector<Node*> nodesVector;
-    for (unsigned int i=2; i < lines.size(); i++) {
-        const std::string & line = lines[i];
+    std::string_view line;
+    InputUtils::getline(stream, line);
+    const Instructions instructions(line);
+
+    Network network;
+    while (InputUtils::getline(stream, line)) {
         if (!line.empty()) {
-            Node * node = new Node(line);
-            nodes[node->getNodeName()] = node;
-            nodesVector.push_back(node);
+            network.addNode(line);
         }
     }
-    std::string currentNode = "AAA";
-    std::queue<direction_e> moveQueue = VectorUtils::convertToQueue(move.getLeftRightDirections());
-    assert(!moveQueue.empty());
+    Runner::markParsed();
+
+    constexpr nodeId finalNode = encodeNode("ZZZ");
+    nodeId currentNode = encodeNode("AAA");
+    size_t instruction = 0;
     puzzleValueType moveCounter = 0;
-    for(;;) {
-        if (moveQueue.empty()) {
-            moveQueue = VectorUtils::convertToQueue(move.getLeftRightDirections());
-        }
-        auto direction = moveQueue.front();
-        moveQueue.pop();
-        // std::cout << "direction:[" << ((direction==Left)? "Left" : "Right") << "]" << std::endl;
-
-        if (direction == Left) {
-            currentNode = nodes[currentNode]->getLeftNodeString();
-            moveCounter++;
-        } else {    //direction == Right
-            currentNode = nodes[currentNode]->getRightNodeString();
-            moveCounter++;
-        }
-        // std::cout << "currentNode:[" << currentNode << "]" << std::endl;
-        if (currentNode == "ZZZ"){
-            break;
-        }
+    while (currentNode != finalNode) {
+        currentNode = network.step(currentNode, instructions.get(instruction));
+        instruction = instructions.next(instruction);
+        moveCounter++;
     }
 
-    puzzleValueType puzzleValue = moveCounter;
-
-    for (Node * node : nodesVector) {
-        delete node;
-    }
-    nodesVector.clear();
-    return puzzleValue;
+    return moveCounter;
 }
 
 
@@ -276,505 +276,342 @@ LR\n\
 XXX = (XXX, XXX)\n";
 constexpr puzzleValueType expectedSolution_problem2 = 6;
 
-class Loop {
-private:
-    std::vector<Node*> nodes;
-    size_t initialStepIndex;    //index in the left-right instructions
-    puzzleValueType moveCounter;    //which move we're on when the loop started
-
-    bool done = false;
+// Binary lifting over the (node, instruction index) states: level k holds where every state is 2^k moves later,
+//  and whether a node ending in Z was reached on the way there. Any walk then takes one lookup per set bit of its length.
+class JumpTable {
+public:
+    using stateType = uint32_t;
 
-    Node * finalNode = nullptr;
+private:
+    static constexpr stateType FINAL_SEEN = stateType(1) << 31;
+    static constexpr stateType STATE_MASK = FINAL_SEEN - 1;
 
-    // -- tracking variables
-    puzzleValueType currentMove = 0;
+    const Network & network;                    //has to outlive the table
+    size_t instructionCount;
+    std::vector<std::vector<stateType>> levels; //target state | FINAL_SEEN; empty when the states don't fit in a stateType
 
 public:
-    Loop() {}
-    Loop(Node * firstNode, size_t initialStepIndex, puzzleValueType moveCounter)
-        : initialStepIndex(initialStepIndex),
-        moveCounter(moveCounter)
+    struct Jump {
+        stateType state;
+        bool finalSeen;
+    };
+
+    // Enough levels to jump at least maxMoves at once; check isValid() afterwards.
+    JumpTable(const Network & network, const Instructions & instructions, puzzleValueType maxMoves) :
+        network(network),
+        instructionCount(instructions.size())
     {
-        nodes.push_back(firstNode);
-    }
-
-    void addStep(Node * addedNode, size_t stepIndex) {
-        if (done) {
+        const size_t nodeCount = network.getNodes().size();
+        if (nodeCount * instructionCount > STATE_MASK) {
             return;
         }
-        if (nodes[0] == addedNode && stepIndex == initialStepIndex) {
-            // full cycle
-            done = true;
+
+        std::vector<stateType> & steps = levels.emplace_back(nodeCount * instructionCount);
+        for (stateType state = 0; state < steps.size(); state++) {
+            const size_t instruction = state % instructionCount;
+            const nodeId next = network.step(getNode(state), instructions.get(instruction));
+            steps[state] = getState(next, instructions.next(instruction)) | (endsWith(next, 'Z')? FINAL_SEEN : 0);
+        }
+
+        while ((puzzleValueType(1) << (levels.size() - 1)) < maxMoves) {
+            const std::vector<stateType> & half = levels.back();
+            std::vector<stateType> doubled(half.size());
+            for (stateType state = 0; state < half.size(); state++) {
+                const stateType first = half[state];
+                const stateType second = half[first & STATE_MASK];
+                doubled[state] = second | (first & FINAL_SEEN);
+            }
+            levels.push_back(std::move(doubled));
         }
-        nodes.push_back(addedNode);
     }
 
-    bool isDone() const {
-        return done;
+    // Whether every (node, instruction index) state fits in a stateType, so the table got built.
+    bool isValid() const {
+        return !levels.empty();
     }
 
-    void print() const {
-        PRINT(moveCounter);
-        PRINT(nodes[0]->getNodeName());
-        PRINT(initialStepIndex);
-        PRINT(nodes.size());
-        for (size_t i=0; i < nodes.size(); i++) {
-            if (nodes[i]->isFinalNode()) {
-                std::cout << "final node at nodes index[" << i << "], name:[" << nodes[i]->getNodeName() << "]" << std::endl;
-            }
-        }
+    // Jumps must be shorter than this.
+    puzzleValueType getMoveLimit() const {
+        return puzzleValueType(1) << levels.size();
+    }
+
+    stateType getState(nodeId node, size_t instruction) const {
+        return network.getIndex(node) * instructionCount + instruction;
+    }
 
-        std::cout << "---" << std::endl;
+    nodeId getNode(stateType state) const {
+        return network.getNodes()[state / instructionCount];
     }
 
-    // --- tracking functions
-    void calculateStartingPosition() {
-        std::set<size_t> finalNodes;
-        for (size_t i=0; i < nodes.size(); i++) {
-            if (nodes[i]->isFinalNode()) {
-                finalNodes.insert(i);
-                std::cout << "final node at nodes index[" << i << "], name:[" << nodes[i]->getNodeName() << "]" << std::endl;
+    // Nothing when moves is negative or not below getMoveLimit().
+    std::optional<Jump> jump(stateType state, puzzleValueType moves) const {
+        if (moves < 0 || moves >= getMoveLimit()) {
+            return std::nullopt;
+        }
+        bool finalSeen = false;
+        for (size_t level = 0; moves != 0; level++, moves >>= 1) {
+            if (moves & 1) {
+                finalSeen |= (levels[level][state] & FINAL_SEEN) != 0;
+                state = levels[level][state] & STATE_MASK;
             }
         }
-        assert(finalNodes.size() == 1);
-
-        finalNode = nodes[*finalNodes.begin()];
+        return Jump{state, finalSeen};
+    }
 
-        //start at final node
-        currentMove = moveCounter + *finalNodes.begin();
-        PRINT((moveCounter + *finalNodes.begin()) % nodes.size());
-        PRINT(moveCounter);
-        PRINT(nodes.size());
-        std::cout << std::endl;
-        // assert (moveCounter + *finalNodes.begin() == nodes.size());
-        while (currentMove > getIncrementSize()) {
-            currentMove -= getIncrementSize();
+    // The number of moves (1 up to maxMoves) after which state first reaches a node ending in Z, if it does.
+    // Nothing as well when maxMoves is beyond getMoveLimit().
+    std::optional<puzzleValueType> firstFinalMove(stateType state, puzzleValueType maxMoves) const {
+        if (maxMoves <= 0 || maxMoves > getMoveLimit()) {
+            return std::nullopt;
         }
+        // take the longest jumps that don't reach one yet, the move after those does
+        puzzleValueType moves = 0;
+        for (size_t level = levels.size(); level-- > 0;) {
+            const stateType target = levels[level][state];
+            if (!(target & FINAL_SEEN) && moves + (puzzleValueType(1) << level) < maxMoves) {
+                state = target & STATE_MASK;
+                moves += puzzleValueType(1) << level;
+            }
+        }
+        if (!(levels[0][state] & FINAL_SEEN)) {
+            return std::nullopt;
+        }
+        return moves + 1;
     }
+};
+
+// A ghost's walk, found in one pass over its (node, instruction index) states:
+//  the first prefixLength moves lead into a cycle of cycleLength moves that repeats forever.
+// finalMoves are the moves of the prefix and the first cycle that end on a node ending in Z.
+class Loop {
+private:
+    nodeId startNode;
+    puzzleValueType prefixLength = 0;
+    puzzleValueType cycleLength = 0;
+    std::vector<puzzleValueType> finalMoves;    //ascending, all below prefixLength + cycleLength
 
-    puzzleValueType getIncrementSize() const {
-        return nodes.size();
+public:
+    Loop(const Network & network, const Instructions & instructions, nodeId startNode) : startNode(startNode) {
+        // The instruction index is the same for every move that is a multiple of the instruction count,
+        //  so the first node that returns at instruction index 0 closes the cycle.
+        std::vector<puzzleValueType> visitedAtInstructionStart(network.getNodes().size(), -1);
+        nodeId node = startNode;
+        size_t instruction = 0;
+        for (puzzleValueType move = 0; ; move++) {
+            if (instruction == 0) {
+                if (visitedAtInstructionStart[network.getIndex(node)] >= 0) {
+                    prefixLength = visitedAtInstructionStart[network.getIndex(node)];
+                    cycleLength = move - prefixLength;
+                    break;
+                }
+                visitedAtInstructionStart[network.getIndex(node)] = move;
+            }
+            if (endsWith(node, 'Z')) {
+                finalMoves.push_back(move);
+            }
+            node = network.step(node, instructions.get(instruction));
+            instruction = instructions.next(instruction);
+        }
+        assert(cycleLength % static_cast<puzzleValueType>(instructions.size()) == 0);
+        LOG(debug, "loop from [" << decodeNode(startNode) << "] prefix:[" << prefixLength << "] cycle:[" << cycleLength << "] final moves:[" << finalMoves.size() << "]");
     }
 
-    void incrementCycle() {
-        currentMove += getIncrementSize();
+    nodeId getStartNode() const {
+        return startNode;
     }
 
-    void incrementBy(puzzleValueType incrementValue) {
-        if ((incrementValue % nodes.size()) != 0) {
-            PRINT(incrementValue);
-            PRINT(nodes.size());
-            PRINT(((incrementValue % nodes.size()) != 0));
-        }
-        assert((incrementValue % nodes.size()) == 0);
-        currentMove += incrementValue;
+    const puzzleValueType & getPrefixLength() const {
+        return prefixLength;
     }
 
-    void decrementBy(puzzleValueType decrementValue) {
-        assert((decrementValue % nodes.size()) == 0);
-        // assert(currentMove > decrementValue);
-        // if (currentMove > decrementValue) {
-        currentMove -= decrementValue;
-        // }
+    const puzzleValueType & getCycleLength() const {
+        return cycleLength;
     }
 
-    void reduceBelow(puzzleValueType decrementBelowValue) {
-        unsigned int steps = (currentMove - decrementBelowValue) / getIncrementSize();    // cast to int to make sure currentMove doesn't surpass incrementToValue.
-        steps++;    //decrement one extra, to make sure the value remains below the decrementBelowValue
-        assert(currentMove >= steps * getIncrementSize());
-        currentMove -= steps * getIncrementSize();
+    const std::vector<puzzleValueType> & getFinalMoves() const {
+        return finalMoves;
     }
 
-    bool incrementToAtMost(puzzleValueType incrementToValue) {
-        // increment in steps of the loop size (getIncrementSize()); at most equalling incrementToValue
-        if (currentMove > incrementToValue) {
-            return incrementToValue == currentMove;
+    // The move below prefixLength + cycleLength that ends on the same node.
+    puzzleValueType getEquivalentMove(puzzleValueType move) const {
+        if (move >= prefixLength) {
+            move = prefixLength + (move - prefixLength) % cycleLength;
         }
-        // assert(currentMove <= incrementToValue);
-        unsigned int steps = (incrementToValue - currentMove) / getIncrementSize();    // cast to int to make sure currentMove doesn't surpass incrementToValue.
-        currentMove += steps * getIncrementSize();
-        return incrementToValue == currentMove;
+        return move;
     }
 
-    const puzzleValueType & getCurrentPosition() const {
-        return currentMove;
+    bool isFinalMove(puzzleValueType move) const {
+        return std::binary_search(finalMoves.begin(), finalMoves.end(), getEquivalentMove(move));
     }
 
-    bool operator<(const Loop & rhs) const {
-        if (currentMove != rhs.currentMove) {
-            return currentMove < rhs.currentMove;
+    // Where the ghost is after any number of moves, without walking there; the jump table only has to cover this loop.
+    // Nothing when it doesn't.
+    std::optional<std::string> getNodeName(const JumpTable & jumpTable, puzzleValueType move) const {
+        if (auto jump = jumpTable.jump(jumpTable.getState(startNode, 0), getEquivalentMove(move))) {
+            return decodeNode(jumpTable.getNode(jump->state));
         }
-        return this < &rhs;
-    }
-    bool operator>(const Loop & rhs) const {
-        if (currentMove != rhs.currentMove) {
-            return currentMove > rhs.currentMove;
-        }
-        return this > &rhs;
+        return std::nullopt;
     }
 
-    std::string getFinalNodeName() const {
-        if (finalNode != nullptr) {
-            return finalNode->getNodeName();
+    // The first move after move that ends on a node ending in Z.
+    std::optional<puzzleValueType> getNextFinalMove(const JumpTable & jumpTable, puzzleValueType move) const {
+        const auto jump = jumpTable.jump(jumpTable.getState(startNode, 0), getEquivalentMove(move));
+        if (!jump) {
+            return std::nullopt;
         }
-        return "";
+        if (auto moves = jumpTable.firstFinalMove(jump->state, prefixLength + cycleLength)) {
+            return move + *moves;
+        }
+        return std::nullopt;
     }
 
-    std::string getNodeName(const puzzleValueType & move) const 
-    {
-        return nodes[(move - moveCounter) % nodes.size()]->getNodeName();
+    // Once in the cycle, the moves ending in Z repeat modulo the cycle length.
+    std::vector<NumberUtils::Congruence<puzzleValueType>> getFinalCongruences() const {
+        std::vector<NumberUtils::Congruence<puzzleValueType>> ret;
+        for (const auto & move : finalMoves) {
+            if (move >= prefixLength) {
+                ret.push_back({move % cycleLength, cycleLength});
+            }
+        }
+        return ret;
     }
 };
 
 template<typename T>
 puzzleValueType solve2(T & stream) {
-    // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
-        lines.push_back(line);
-    }
-
-    // Parse to data types
-    std::cout << std::endl;
-    AvailableMove move(lines[0]);
-    std::unordered_map<std::string, Node*> nodesMap;
-    std::vector<Node*> nodesVector;
-    for (unsigned int i=2; i < lines.size(); i++) {
-        const std::string & line = lines[i];
+    std::string_view line;
+    InputUtils::getline(stream, line);
+    const Instructions instructions(line);
+
+    Network network;
+    while (InputUtils::getline(stream, line)) {
         if (!line.empty()) {
-            Node * node = new Node(line);
-            nodesMap[node->getNodeName()] = node;
-            nodesVector.push_back(node);
+            network.addNode(line);
         }
     }
+    Runner::markParsed();
 
-    //post process nodes
-    std::cout << "Final nodes:[";
-    for (Node * node : nodesVector) {
-        node->setLeftNode(nodesMap.at(node->getLeftNodeString()));
-        node->setRightNode(nodesMap.at(node->getRightNodeString()));
-
-        if (node->getNodeName()[2] == 'Z') {
-            std::cout << node->getNodeName() << ", ";
-            node->setFinalNode();
+    std::vector<Loop> loops;
+    for (const auto & node : network.getNodes()) {
+        if (endsWith(node, 'A')) {
+            loops.emplace_back(network, instructions, node);
         }
     }
-    std::cout << "]" << std::endl;
+    assert(!loops.empty());
 
-    // Get starting nodes
-    std::vector<Node*> currentNodes;
-    std::cout << "Start nodes:[";
-    for (Node * node : nodesVector) {
-        if (node->getNodeName()[2] == 'A') {
-            std::cout << node->getNodeName() << ", ";
-            currentNodes.push_back(node);
+    // Before every ghost is in its cycle, the answer must be one of the prefix final moves of the ghost with the longest prefix.
+    const Loop & longestPrefix = *std::max_element(loops.begin(), loops.end(), [](const Loop & lhs, const Loop & rhs) {
+        return lhs.getPrefixLength() < rhs.getPrefixLength();
+    });
+    for (const auto & move : longestPrefix.getFinalMoves()) {
+        if (move >= longestPrefix.getPrefixLength()) {
+            break;
+        }
+        if (std::all_of(loops.begin(), loops.end(), [&move](const Loop & loop) { return loop.isFinalMove(move); })) {
+            return move;
         }
     }
-    std::cout << "]" << std::endl;
-
-    std::queue<direction_e> moveQueue = VectorUtils::convertToQueue(move.getLeftRightDirections());
-    std::unordered_map<size_t, std::unordered_map<size_t, std::set<Node*> > > history;
-    std::unordered_map<size_t, Loop> loopHistory;
-    std::set<size_t> ghostsStuckInALoop;
-    unsigned int loopsDone = 0;
 
-    puzzleValueType stepCounter = 0;
-    for (unsigned int i=0; i < currentNodes.size(); i++) {
-        history[i][moveQueue.size()].insert(currentNodes[i]);
-    }
-    assert(!moveQueue.empty());
-    puzzleValueType moveCounter = 0;
-    while(loopsDone < currentNodes.size()) {
-        if (moveQueue.empty()) {
-            moveQueue = VectorUtils::convertToQueue(move.getLeftRightDirections());
-        }
-        auto direction = moveQueue.front();
-        moveQueue.pop();
-
-        for (unsigned int i=0; i < currentNodes.size(); i++) {
-            if (direction == Left) {
-                currentNodes[i] = currentNodes[i]->getLeftNode();
-            } else {    //direction == Right
-                currentNodes[i] = currentNodes[i]->getRightNode();
-            }
-            if (currentNodes[i]->isFinalNode()) {
-                std::cout << "Final node [" << currentNodes[i]->getNodeName() << "] at [" << moveCounter << "]" << std::endl;
-            }
-            if (ghostsStuckInALoop.contains(i)) {
-                if (!loopHistory[i].isDone()) {
-                    loopHistory[i].addStep(currentNodes[i], move.getLeftRightDirections().size() - moveQueue.size());
-                    if (loopHistory[i].isDone()) {
-                        loopsDone++;
-                    }
+    // After that every ghost is on a Z node at a few remainders modulo its cycle length; all of them at once
+    //  wherever one remainder of every ghost agrees.
+    std::vector<NumberUtils::Congruence<puzzleValueType>> candidates = {{0, 1}};
+    for (const auto & loop : loops) {
+        std::vector<NumberUtils::Congruence<puzzleValueType>> combined;
+        for (const auto & candidate : candidates) {
+            for (const auto & congruence : loop.getFinalCongruences()) {
+                NumberUtils::Congruence<puzzleValueType> both;
+                const auto result = NumberUtils::combineCongruences(candidate, congruence, both);
+                if (result == NumberUtils::e_overflow) {
+                    std::cerr << "day8: the ghost cycles only line up after more moves than fit in a puzzleValueType" << std::endl;
+                    return -1;
                 }
-            }
-            auto [_, inserted] = history[i][moveQueue.size()].insert(currentNodes[i]);
-            if (!inserted) {
-                if (!ghostsStuckInALoop.contains(i)) {
-                    std::cout << "ghost stuck in a loop:[" << i << "] at [" << currentNodes[i]->getNodeName() << "]" << std::endl;
-                    ghostsStuckInALoop.insert(i);
-                    loopHistory.emplace(i, Loop(currentNodes[i], move.getLeftRightDirections().size() - moveQueue.size(), moveCounter));
+                if (result == NumberUtils::e_combined) {
+                    combined.push_back(both);
                 }
             }
         }
-        moveCounter++;
-
-        bool success = true;
-        // std::cout << "Final nodes check:[";
-        for (Node * currentNode : currentNodes) {
-            // std::cout << currentNode->getNodeName() << ", ";
-            if (!currentNode->isFinalNode()){
-                success = false;
-            }
-        }
-        // std::cout << "] [" << success << "]" << std::endl;
-
-        if (success) {
-            break;
-        }
+        candidates = std::move(combined);
     }
 
-
-    PRINT(loopHistory.size());
-
-    std::cout << "--" << std::endl;
-    for (const auto & [ghostIndex, loop] : loopHistory) {
-        loop.print();
-    }
-    std::cout << "0" << std::endl;
-
-    // Calculate the initial starting position per loop and put loops in sorting set.
-    std::set<Loop> sortedLoops;
-    for (auto & [ghostIndex, loop] : loopHistory) {
-        loop.calculateStartingPosition();
-        sortedLoops.insert(loop);
-    }
-    std::cout << "1" << std::endl;
-
-    assert(sortedLoops.size() == currentNodes.size());
-
-    // put sorted loops in array
-    Loop _runningLoops[currentNodes.size()];
-    Loop * runningLoops[currentNodes.size()];
-    size_t counter = 0;
-    for (const Loop & loop : sortedLoops) {
-        _runningLoops[counter] = loop;
-        runningLoops[counter] = &_runningLoops[counter];
-        counter++;
+    if (candidates.empty()) {
+        std::cerr << "day8: the ghosts are never on Z nodes at the same time" << std::endl;
+        return -1;
     }
-    std::cout << "2" << std::endl;
 
-
-    // Prep loop history
-    std::unordered_map<Loop*, std::unordered_map<Loop*, puzzleValueType> > metaLoopHistory;
-    for (unsigned int i=0; i < sizeof(runningLoops)/sizeof(runningLoops[0]); i++) {
-        for (unsigned int i2=0; i2 < sizeof(runningLoops)/sizeof(runningLoops[0]); i2++) {
-            metaLoopHistory[runningLoops[i]][runningLoops[i2]] = 0;
+    const puzzleValueType firstMoveInAllCycles = longestPrefix.getPrefixLength();
+    puzzleValueType puzzleValue = 0;
+    for (const auto & [remainder, modulus] : candidates) {
+        // the first move at or after firstMoveInAllCycles with this remainder
+        NumberUtils::int128Type move = remainder;
+        if (move < firstMoveInAllCycles) {
+            move += (firstMoveInAllCycles - move + modulus - 1) / modulus * modulus;
+        }
+        if (move > std::numeric_limits<puzzleValueType>::max()) {
+            continue;   //a later candidate may still fit
+        }
+        if (puzzleValue == 0 || move < puzzleValue) {
+            puzzleValue = static_cast<puzzleValueType>(move);
         }
     }
-
-    // Play out scenario
-    constexpr puzzleValueType printBarrierStepSize = 1000000000;
-    puzzleValueType printBarrier = printBarrierStepSize;
-    puzzleValueType incrementSize = 0;
-    // std::set<Loop*> loopsToIncrement;
-    std::set<Loop*> syncedLoops;
-    std::set<Loop*> loopsStillUnsynced;
-    for (unsigned int i=0; i < sizeof(runningLoops)/sizeof(runningLoops[0]); i++) {
-        loopsStillUnsynced.insert(runningLoops[i]);
+    if (puzzleValue == 0) {
+        std::cerr << "day8: the ghosts only line up after more moves than fit in a puzzleValueType" << std::endl;
+        return -1;
     }
 
-    // Find lowest incrementsize loop and use it as initial synced loop.
-    Loop * syncedLoop = runningLoops[0];
-    for (unsigned int i=1; i < sizeof(runningLoops)/sizeof(runningLoops[0]); i++) {
-        if (runningLoops[i]->getIncrementSize() < syncedLoop->getIncrementSize()) {
-            syncedLoop = runningLoops[i];
-        }
+    // Check the cycle analysis by fast-forwarding every ghost instead; the jump table only has to cover one loop.
+    puzzleValueType maxMoves = 0;
+    for (const auto & loop : loops) {
+        maxMoves = std::max(maxMoves, loop.getPrefixLength() + loop.getCycleLength());
     }
-
-    for (unsigned int i=0; i < sizeof(runningLoops)/sizeof(runningLoops[0]); i++) {
-        PRINT(runningLoops[i]->getCurrentPosition());
+    const JumpTable jumpTable(network, instructions, maxMoves);
+    if (!jumpTable.isValid()) {
+        std::cerr << "day8: too many nodes and instructions for the jump table" << std::endl;
+        return -1;
     }
-
-    syncedLoops.insert(syncedLoop);
-    incrementSize = syncedLoop->getIncrementSize();
-    loopsStillUnsynced.erase(syncedLoop);
-
-    PRINT(syncedLoop->getFinalNodeName());
-
-    while (true) {
-    // while (runningLoops[0]->getCurrentPosition() != runningLoops[sizeof(runningLoops)/sizeof(runningLoops[0])-1]->getCurrentPosition()) {
-        // increment by cycle
-        // std::cout << "A" << std::endl;
-        // if (incrementSize != 0) {
-        for (Loop * syncedLoopToIncrement : syncedLoops) {
-            syncedLoopToIncrement->incrementBy(incrementSize);
-            assert (syncedLoopToIncrement->getCurrentPosition() == syncedLoop->getCurrentPosition());
-
-            if((syncedLoopToIncrement->getNodeName(syncedLoopToIncrement->getCurrentPosition())[2] != 'Z')) {
-                PRINT(syncedLoopToIncrement->getNodeName(syncedLoopToIncrement->getCurrentPosition()));
-                PRINT(syncedLoopToIncrement->getFinalNodeName());
-                PRINT(syncedLoop->getCurrentPosition());
-            }
-            assert(syncedLoopToIncrement->getNodeName(syncedLoop->getCurrentPosition())[2] == 'Z');
+    for (const auto & loop : loops) {
+        const std::optional<std::string> nodeName = loop.getNodeName(jumpTable, puzzleValue);
+        if (!nodeName) {
+            std::cerr << "day8: the jump table doesn't cover the loop from [" << decodeNode(loop.getStartNode()) << "]" << std::endl;
+            return -1;
         }
-
-        std::set<Loop*> possiblySyncedLoops;
-        for (Loop * unsyncedLoopToIncrement : loopsStillUnsynced) {
-            bool synced = unsyncedLoopToIncrement->incrementToAtMost(syncedLoop->getCurrentPosition());
-            if (synced) {
-                possiblySyncedLoops.insert(unsyncedLoopToIncrement);
-            }
+        LOG(debug, "after [" << puzzleValue << "] moves at [" << *nodeName << "]");
+        if (nodeName->back() != 'Z') {
+            std::cerr << "day8: a ghost is at [" << *nodeName << "] after [" << puzzleValue << "] moves" << std::endl;
+            return -1;
         }
-
-        assert(possiblySyncedLoops.size() <= 1);
-
-        if (loopsStillUnsynced.size() == 1) {
-            assert(possiblySyncedLoops.empty());
+#ifndef NDEBUG
+        const auto & finalMoves = loop.getFinalMoves();
+        for (size_t i=1; i < finalMoves.size(); i++) {
+            assert(loop.getNextFinalMove(jumpTable, finalMoves[i-1]) == finalMoves[i]);
         }
-
-        // for (Loop * possiblySyncedLoop : possiblySyncedLoops) {
-        if (loopsStillUnsynced.size() == 1 && possiblySyncedLoops.size() == 1) {
-            break;
-        }
-        if (!possiblySyncedLoops.empty())
-        {
-            Loop * possiblySyncedLoop = *possiblySyncedLoops.begin();
-            assert (possiblySyncedLoop->getCurrentPosition() == syncedLoop->getCurrentPosition());
-            assert (possiblySyncedLoop!= syncedLoop);
-
-            if (metaLoopHistory[syncedLoop][possiblySyncedLoop] > 0) {
-                //got a sync
-                puzzleValueType incrementForNewSync = syncedLoop->getCurrentPosition() - metaLoopHistory[syncedLoop][possiblySyncedLoop];
-                assert ((incrementForNewSync % incrementSize) == 0);    //assert the new increment size is a plural of the previous increment size.
-                incrementSize = incrementForNewSync;
-
-                // clear history, it's no longer usable in my naive solution, and needs to be re-established
-                for (unsigned int i=0; i < sizeof(runningLoops)/sizeof(runningLoops[0]); i++) {
-                    for (unsigned int i2=0; i2 < sizeof(runningLoops)/sizeof(runningLoops[0]); i2++) {
-                        metaLoopHistory[runningLoops[i]][runningLoops[i2]] = 0;
-                    }
-                }
-
-                // possiblySyncedLoop is now definitely synced.
-                loopsStillUnsynced.erase(possiblySyncedLoop);
-                syncedLoops.insert(possiblySyncedLoop);
-                std::cout << "added synced loop:[" << syncedLoop->getCurrentPosition() << "]" << std::endl;
-                PRINT(incrementSize);
-                PRINT(loopsStillUnsynced.size());
-
-                // Reduce currentPositions to lowest possible value.
-                while (syncedLoop->getCurrentPosition() > incrementSize) {
-                    for (Loop * syncedLoopToIncrement : syncedLoops) {
-                        syncedLoopToIncrement->decrementBy(incrementSize);
-                    }
-                }
-
-                for (Loop * loop : loopsStillUnsynced) {
-                    loop->reduceBelow(syncedLoop->getCurrentPosition());
-                }
-
-                std::cout << "> continuing from: " << syncedLoop->getCurrentPosition() << std::endl;
-
-                std::cout << "> unsynced loops: " << std::endl;
-                for (Loop * loop : loopsStillUnsynced) {
-                    std::cout << " > > "<< loop->getCurrentPosition() << std::endl;
-                }
-
-                //reduce synced loops for an additional step, it will be added in the next cycle again anyway and we need to check for this value.
-                for (Loop * syncedLoopToIncrement : syncedLoops) {
-                    syncedLoopToIncrement->decrementBy(incrementSize);
-                }
-
-
-            } else {
-                metaLoopHistory[syncedLoop][possiblySyncedLoop] = syncedLoop->getCurrentPosition();
-                metaLoopHistory[possiblySyncedLoop][syncedLoop] = syncedLoop->getCurrentPosition();
-            }
+        const auto firstInCycle = std::lower_bound(finalMoves.begin(), finalMoves.end(), loop.getPrefixLength());
+        if (firstInCycle != finalMoves.end()) {
+            assert(loop.getNextFinalMove(jumpTable, finalMoves.back()) == *firstInCycle + loop.getCycleLength());
         }
+#endif
+    }
 
-        if (loopsStillUnsynced.empty()) {
-            break;
-        }
+    return puzzleValue;
+}
 
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(8, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
 
-        // } else {
-        //     runningLoops[0]->incrementCycle();
-        // }
-
-        // // std::cout << "B" << std::endl;
-        // //re-sort
-        // for (unsigned int i=1; i < sizeof(runningLoops)/sizeof(runningLoops[0]); i++) {
-        //     // PRINT(i);
-        //     if (*runningLoops[i-1] > *runningLoops[i]) {
-        //         // Swap
-        //         // std::swap(runningLoops[i-1], runningLoops[i]);
-        //         Loop * t = runningLoops[i-1];
-        //         runningLoops[i-1] = runningLoops[i];
-        //         runningLoops[i] = t;
-        //     }
-        // }
-
-        // // if (incrementSize != 0) {
-        // for (unsigned int i=1; i < sizeof(runningLoops)/sizeof(runningLoops[0]); i++) {
-        //     Loop * loopA = runningLoops[i-1];
-        //     Loop * loopB = runningLoops[i];
-        //     if (loopA->getCurrentPosition() == loopB->getCurrentPosition()) {
-        //         if (incrementSize > 0) {
-        //         } else {
-        //             if (metaLoopHistory[loopA][loopB] > 0) {
-        //                 //get initial larger step size.
-        //                 if (loopA->getCurrentPosition() != metaLoopHistory[loopA][loopB]) {
-        //                     incrementSize = loopA->getCurrentPosition() - metaLoopHistory[loopA][loopB];
-        //                     PRINT(incrementSize);
-        //                     PRINT(loopA->getCurrentPosition());
-        //                     PRINT(metaLoopHistory[loopA][loopB]);
-
-        //                     syncedLoops.insert(loopA);
-        //                     syncedLoops.insert(loopB);
-        //                     loopsStillUnsynced.erase(loopA);
-        //                     loopsStillUnsynced.erase(loopB);
-        //                     // assert(false);
-        //                 }
-        //             } else {
-        //                 metaLoopHistory[loopA][loopB] = loopA->getCurrentPosition();
-        //                 metaLoopHistory[loopB][loopA] = loopA->getCurrentPosition();
-        //             }
-        //         }
-        //     }
-        // }
-        // // std::cout << "C" << std::endl;
-
-        // if (runningLoops[0]->getCurrentPosition() > printBarrier) {
-        //     printBarrier += printBarrierStepSize;
-        //     for (unsigned int i=0; i < sizeof(runningLoops)/sizeof(runningLoops[0]); i++) {
-        //         PRINT(runningLoops[i]->getCurrentPosition());
-        //     }
-        //     std::cout << std::endl;
-        // }
-    }
-
-    for (unsigned int i=0; i < sizeof(runningLoops)/sizeof(runningLoops[0]); i++) {
-        PRINT(runningLoops[i]->getCurrentPosition());
-    }
-
-    puzzleValueType puzzleValue = runningLoops[0]->getCurrentPosition();
-
-    for (Node * node : nodesVector) {
-        delete node;
-    }
-    nodesVector.clear();
-    return puzzleValue;
-}
+}; // namespace day8
 
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day8;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -792,21 +629,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
@@ -1,21 +1,25 @@
 #include "CoordinateUtils.hpp"
 #include "CoutUtils.hpp"
+#include "InputUtils.hpp"
 #include "NumberUtils.hpp"
+#include "ParallelUtils.hpp"
 #include "StringUtils.hpp"
 #include "VectorUtils.hpp"
 #include "RangeUtils.hpp"
+#include "Runner.hpp"
 
 #include <cassert>
 #include <cctype>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <queue>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 
+namespace day9 {
+
 // --- Day 9: Mirage Maintenance ---
 // You ride the camel through the sandstorm and stop where the ghost's maps told you to stop.
 // The sandstorm subsequently subsides, somehow seeing you standing at an oasis!
@@ -115,11 +119,8 @@ class Sequence {
 private:
     std::vector<puzzleValueType> sequence;
 public:
-    Sequence(const std::string & line) {
-        auto lineFractions = StringUtils::split(line, " ");
-        for (auto & lineFraction : lineFractions) {
-            sequence.push_back(std::stoll(lineFraction));
-        }
+    Sequence(std::string_view line) {
+        NumberUtils::parseNumbers(line, sequence);
     }
 
     Sequence(std::vector<puzzleValueType> && input) {
@@ -172,22 +173,22 @@ public:
 template<typename T>
 puzzleValueType solve1(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // convert to sequences
-    std::vector<Sequence> startingSequences;
-    for (const auto & line : lines) {
-        startingSequences.push_back(Sequence(line));
-    }
+    const std::vector<Sequence> startingSequences = ParallelUtils::parallelTransform(lines.size(), [&lines](size_t i) {
+        return Sequence(lines[i]);
+    });
+
+    Runner::markParsed();
 
-    puzzleValueType puzzleValue = 0;
     // Compute puzzel value
-    for (const auto & sequence : startingSequences) {
-        puzzleValue += sequence.predictNextValue();
-    }
+    puzzleValueType puzzleValue = ParallelUtils::parallelReduce(startingSequences.size(), puzzleValueType(0), [&startingSequences](size_t i) {
+        return startingSequences[i].predictNextValue();
+    });
 
     return puzzleValue;
 }
@@ -226,33 +227,43 @@ constexpr puzzleValueType expectedSolution_problem2 = 2;
 template<typename T>
 puzzleValueType solve2(T & stream) {
     // convert to lines
-    std::vector<std::string> lines;
-    for (std::string line; std::getline(stream, line);) {
+    std::vector<std::string_view> lines;
+    for (std::string_view line; InputUtils::getline(stream, line);) {
         lines.push_back(line);
     }
 
     // convert to sequences
-    std::vector<Sequence> startingSequences;
-    for (const auto & line : lines) {
-        startingSequences.push_back(Sequence(line));
-    }
+    const std::vector<Sequence> startingSequences = ParallelUtils::parallelTransform(lines.size(), [&lines](size_t i) {
+        return Sequence(lines[i]);
+    });
+
+    Runner::markParsed();
 
-    puzzleValueType puzzleValue = 0;
     // Compute puzzel value
-    for (const auto & sequence : startingSequences) {
-        puzzleValue += sequence.predictPreviousValue();
-    }
+    puzzleValueType puzzleValue = ParallelUtils::parallelReduce(startingSequences.size(), puzzleValueType(0), [&startingSequences](size_t i) {
+        return startingSequences[i].predictPreviousValue();
+    });
 
     return puzzleValue;
 }
 
+#ifdef AOC_RUNNER
+const Runner::Registration registration(9, solve1<InputUtils::LineReader>, solve2<InputUtils::LineReader>,
+    givenTestData_problem1, expectedSolution_problem1,
+    givenTestData_problem2, expectedSolution_problem2);
+#endif
+
+}; // namespace day9
+
+#ifndef AOC_RUNNER
 int main(int argc, char ** argv) {
-    std::stringstream inputStream;
+    using namespace day9;
+
     if (argc == 1) {
-        std::stringstream strStream_problem1(givenTestData_problem1);
-        const auto solve1_solution = solve1(strStream_problem1);
-        std::stringstream strStream_problem2(givenTestData_problem2);
-        const auto solve2_solution = solve2(strStream_problem2);
+        InputUtils::LineReader testData_problem1(givenTestData_problem1);
+        const auto solve1_solution = solve1(testData_problem1);
+        InputUtils::LineReader testData_problem2(givenTestData_problem2);
+        const auto solve2_solution = solve2(testData_problem2);
 
         if (solve1_solution == expectedSolution_problem1) {
             std::cout << "Puzzle A <Success!> :[" << solve1_solution << "]" << std::endl;
@@ -270,21 +281,22 @@ int main(int argc, char ** argv) {
         std::cout << "Trying to input file:[" << url << "]" << std::endl;
         std::filesystem::path path(url);
 
-        std::ifstream fileStream;
-        fileStream.open(path);
-        if (!fileStream.is_open()) {
-            std::cout << "fileStream is NOT Open!" << std::endl;
+        InputUtils::MappedFile file(path);
+        if (!file.is_open()) {
+            std::cout << "file is NOT Open!" << std::endl;
             return -1;
         }
+        InputUtils::LineReader fileInput(file);
 
         if (argc == 2 || (argc == 3 && argv[2][0] == 'A')) {
-            auto solve1_solution = solve1(fileStream);
+            auto solve1_solution = solve1(fileInput);
             std::cout << "Puzzle A result :[" << solve1_solution << "]" << std::endl;
         } else if(argc == 3 && argv[2][0] == 'B') {
-            auto solve2_solution = solve2(fileStream);
+            auto solve2_solution = solve2(fileInput);
             std::cout << "Puzzle B result :[" << solve2_solution << "]" << std::endl;
         }
     }
 
     return 0;
 }
+#endif
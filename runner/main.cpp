@@ -0,0 +1,239 @@
+#include "InputUtils.hpp"
+#include "Runner.hpp"
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 'aoc' runs any subset of the registered days and reports, per part, the answer,
+//  the parse time, the solve time and the peak RSS as JSON on stdout.
+//
+// usage: aoc [--test] [--inputs <directory>] [--verbose] [selection...]
+//  selection: '5' (both parts), '5A', '5B', '3-7', 'all' (the default)
+//  --test      run the embedded test data and compare with the expected solutions
+//  --inputs    directory holding dayN/input1.txt (default: the source tree)
+//  --verbose   forward the solvers' own output to stderr instead of dropping it
+
+namespace {
+    struct Selection {
+        int firstDay;
+        int lastDay;
+        bool parts[2];
+    };
+
+    struct Measurement {
+        Runner::solutionType result = 0;
+        double loadSeconds = 0;
+        std::optional<double> parseSeconds;
+        double solveSeconds = 0;
+        long peakRssKiB = -1;
+    };
+
+    bool parseSelection(std::string_view argument, Selection & selection) {
+        selection = {1, 25, {true, true}};
+        if (argument == "all") {
+            return true;
+        }
+
+        if (!argument.empty() && (argument.back() == 'A' || argument.back() == 'B')) {
+            selection.parts[0] = argument.back() == 'A';
+            selection.parts[1] = argument.back() == 'B';
+            argument.remove_suffix(1);
+        }
+
+        auto dash = argument.find('-');
+        try {
+            if (dash == std::string_view::npos) {
+                selection.firstDay = std::stoi(std::string(argument));
+                selection.lastDay = selection.firstDay;
+            } else {
+                selection.firstDay = std::stoi(std::string(argument.substr(0, dash)));
+                selection.lastDay = std::stoi(std::string(argument.substr(dash + 1)));
+            }
+        } catch (const std::exception &) {
+            return false;
+        }
+        return selection.firstDay <= selection.lastDay;
+    }
+
+    bool isSelected(const std::vector<Selection> & selections, int day, int part) {
+        if (selections.empty()) {
+            return true;
+        }
+        return std::any_of(selections.begin(), selections.end(), [day, part](const Selection & selection) {
+            return day >= selection.firstDay && day <= selection.lastDay && selection.parts[part];
+        });
+    }
+
+    // Resets the kernel's high water mark of this process, so VmHWM afterwards only covers the next part.
+    // The heap left behind by earlier parts is handed back first, otherwise it would still count.
+    void resetPeakRss() {
+        ::malloc_trim(0);
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5";
+    }
+
+    long getPeakRssKiB() {
+        std::ifstream status("/proc/self/status");
+        for (std::string line; std::getline(status, line);) {
+            if (line.rfind("VmHWM:", 0) == 0) {
+                return std::stol(line.substr(6));
+            }
+        }
+        return -1;
+    }
+
+    double toSeconds(Runner::Clock::duration duration) {
+        return std::chrono::duration<double>(duration).count();
+    }
+
+    std::string toJsonString(std::string_view input) {
+        std::string ret = "\"";
+        for (const auto & c : input) {
+            if (c == '"' || c == '\\') {
+                ret += '\\';
+            }
+            ret += c;
+        }
+        return ret + "\"";
+    }
+
+    Measurement measure(const Runner::solveFunction & solve, const std::optional<std::filesystem::path> & path, std::string_view testData, bool & ok) {
+        Measurement ret;
+        resetPeakRss();
+
+        const auto loadStart = Runner::Clock::now();
+        std::optional<InputUtils::MappedFile> file;
+        if (path) {
+            file.emplace(*path);
+            if (!file->is_open()) {
+                ok = false;
+                return ret;
+            }
+        }
+        InputUtils::LineReader input = file ? InputUtils::LineReader(*file) : InputUtils::LineReader(testData);
+
+        Runner::getParsedTimePoint().reset();
+        const auto start = Runner::Clock::now();
+        ret.result = solve(input);
+        const auto end = Runner::Clock::now();
+
+        const auto & parsed = Runner::getParsedTimePoint();
+        ret.loadSeconds = toSeconds(start - loadStart);
+        if (parsed) {
+            ret.parseSeconds = toSeconds(*parsed - start);
+            ret.solveSeconds = toSeconds(end - *parsed);
+        } else {
+            ret.solveSeconds = toSeconds(end - start);
+        }
+        ret.peakRssKiB = getPeakRssKiB();
+        ok = true;
+        return ret;
+    }
+};
+
+int main(int argc, char ** argv) {
+    bool testMode = false;
+    bool verbose = false;
+    std::filesystem::path inputDirectory(AOC_SOURCE_DIR);
+    std::vector<Selection> selections;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view argument(argv[i]);
+        if (argument == "--test") {
+            testMode = true;
+        } else if (argument == "--verbose") {
+            verbose = true;
+        } else if (argument == "--inputs" && i + 1 < argc) {
+            inputDirectory = argv[++i];
+        } else {
+            Selection selection;
+            if (!parseSelection(argument, selection)) {
+                std::cerr << "unknown argument:[" << argument << "]" << std::endl;
+                std::cerr << "usage: aoc [--test] [--inputs <directory>] [--verbose] [N | NA | NB | N-M | all]..." << std::endl;
+                return -1;
+            }
+            selections.push_back(selection);
+        }
+    }
+
+    auto puzzles = Runner::getPuzzles();
+    std::sort(puzzles.begin(), puzzles.end(), [](const Runner::Puzzle & lhs, const Runner::Puzzle & rhs) {
+        return lhs.day < rhs.day;
+    });
+
+    // The solvers print plenty of progress on std::cout; keep stdout for the JSON report.
+    std::ostream report(std::cout.rdbuf());
+    std::cout.rdbuf(verbose ? std::cerr.rdbuf() : nullptr);
+
+    report << std::setprecision(9);
+    report << "[";
+    bool first = true;
+    int failures = 0;
+    for (const auto & puzzle : puzzles) {
+        for (int part = 0; part < 2; part++) {
+            if (!isSelected(selections, puzzle.day, part)) {
+                continue;
+            }
+
+            std::optional<std::filesystem::path> path;
+            std::string inputName = "test";
+            if (testMode) {
+                if (puzzle.givenTestData[part].empty()) {
+                    continue;
+                }
+            } else {
+                path = (inputDirectory / ("day" + std::to_string(puzzle.day)) / "input1.txt").lexically_normal();
+                inputName = path->string();
+            }
+
+            if (verbose) {
+                std::cerr << "--- day" << puzzle.day << (part == 0 ? 'A' : 'B') << " ---" << std::endl;
+            }
+            bool ok = false;
+            const auto measurement = measure(puzzle.solve[part], path, puzzle.givenTestData[part], ok);
+
+            report << (first ? "\n" : ",\n");
+            first = false;
+            report << "  {\"day\": " << puzzle.day
+                   << ", \"part\": \"" << (part == 0 ? 'A' : 'B') << "\""
+                   << ", \"input\": " << toJsonString(inputName);
+            if (!ok) {
+                report << ", \"error\": \"cannot open input\"}";
+                failures++;
+                continue;
+            }
+            report << ", \"result\": " << measurement.result;
+            if (testMode) {
+                const auto & expected = puzzle.expectedSolution[part];
+                if (expected) {
+                    report << ", \"expected\": " << *expected << ", \"match\": " << (*expected == measurement.result ? "true" : "false");
+                    failures += *expected == measurement.result ? 0 : 1;
+                } else {
+                    report << ", \"expected\": null, \"match\": null";
+                }
+            }
+            report << ", \"loadSeconds\": " << measurement.loadSeconds
+                   << ", \"parseSeconds\": ";
+            if (measurement.parseSeconds) {
+                report << *measurement.parseSeconds;
+            } else {
+                report << "null";
+            }
+            report << ", \"solveSeconds\": " << measurement.solveSeconds
+                   << ", \"peakRssKiB\": " << measurement.peakRssKiB << "}";
+        }
+    }
+    report << "\n]" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
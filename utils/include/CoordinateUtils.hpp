@@ -37,7 +37,7 @@ namespace CoordinateUtils {
     using LCoordinates = TCoordinates<long int>;
 
 
-    bool isAdjacent(const ICoordinates & lhs, const ICoordinates & rhs) {
+    inline bool isAdjacent(const ICoordinates & lhs, const ICoordinates & rhs) {
         for (int x=-1; x < 2; x++) {
             for (int y=-1; y < 2; y++) {
                 if (lhs == ICoordinates{rhs.x + x, rhs.y + y}) {
@@ -48,7 +48,7 @@ namespace CoordinateUtils {
         return false;
     }
 
-    ICoordinates invert(const ICoordinates & rhs) {
+    inline ICoordinates invert(const ICoordinates & rhs) {
         return {-rhs.x, -rhs.y};
     }
 
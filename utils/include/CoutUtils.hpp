@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Grid.hpp"
+
 #include <iostream>
 #include <string>
 #include <vector>
@@ -7,19 +9,64 @@
 
 #define STR(toString) #toString
 
-#define PRINT(variable) CoutUtils::print(std::string(STR(variable)), variable)
+// Log levels for LOG(level, message); AOC_LOG_LEVEL is the highest one that is still printed.
+// Release builds (NDEBUG) default to 0, which compiles every LOG away; debug builds print everything.
+#define AOC_LOG_LEVEL_NONE 0
+#define AOC_LOG_LEVEL_INFO 1
+#define AOC_LOG_LEVEL_DEBUG 2
+#define AOC_LOG_LEVEL_TRACE 3
+
+#ifndef AOC_LOG_LEVEL
+#ifdef NDEBUG
+#define AOC_LOG_LEVEL AOC_LOG_LEVEL_NONE
+#else
+#define AOC_LOG_LEVEL AOC_LOG_LEVEL_TRACE
+#endif
+#endif
+
+// LOG(debug, "line:[" << line << "]"); writes one line without flushing std::cout.
+#define LOG(level, message) \
+    do { \
+        if constexpr (CoutUtils::isLogging(CoutUtils::e_##level)) { \
+            std::cout << message << '\n'; \
+        } \
+    } while (false)
+
+// Same as LOG, but leaves the line open for more LOG_PART/LOG calls.
+#define LOG_PART(level, message) \
+    do { \
+        if constexpr (CoutUtils::isLogging(CoutUtils::e_##level)) { \
+            std::cout << message; \
+        } \
+    } while (false)
+
+#define PRINT(variable) LOG(debug, STR(variable) << ":[" << (variable) << "]")
 
 namespace CoutUtils {
+    enum logLevel_e {
+        e_none = AOC_LOG_LEVEL_NONE,
+        e_info = AOC_LOG_LEVEL_INFO,
+        e_debug = AOC_LOG_LEVEL_DEBUG,
+        e_trace = AOC_LOG_LEVEL_TRACE
+    };
+
+    // For whole blocks of printing: if constexpr (CoutUtils::isLogging(CoutUtils::e_trace)) { ... }
+    constexpr bool isLogging(logLevel_e level) {
+        return level != e_none && level <= AOC_LOG_LEVEL;
+    }
+
     template<typename T>
     void print2d(const std::string & name, const std::vector<std::vector<T>> & twoDimensionalArray) {
-        if (!name.empty()){
-            std::cout << name << std::endl;
-        }
-        for (const auto & line : twoDimensionalArray) {
-            for (const auto & c : line) {
-                std::cout << c;
+        if constexpr (isLogging(e_debug)) {
+            if (!name.empty()){
+                std::cout << name << '\n';
+            }
+            for (const auto & line : twoDimensionalArray) {
+                for (const auto & c : line) {
+                    std::cout << c;
+                }
+                std::cout << '\n';
             }
-            std::cout << std::endl;
         }
     }
     template<typename T>
@@ -27,7 +74,26 @@ namespace CoutUtils {
         print2d("", twoDimensionalArray);
     }
 
-    std::string convertToString(const std::string & name, const std::vector<std::string> & input) {
+    template<typename T>
+    void print2d(const std::string & name, const Grid<T> & grid) {
+        if constexpr (isLogging(e_debug)) {
+            if (!name.empty()){
+                std::cout << name << '\n';
+            }
+            for (size_t y=0; y < grid.getHeight(); y++) {
+                for (const auto & c : grid.row(y)) {
+                    std::cout << c;
+                }
+                std::cout << '\n';
+            }
+        }
+    }
+    template<typename T>
+    void print2d(const Grid<T> & grid) {
+        print2d("", grid);
+    }
+
+    inline std::string convertToString(const std::string & name, const std::vector<std::string> & input) {
         std::string ret = name + ": [";
         for (unsigned int i=0; i < input.size(); i++) {
             ret += input[i];
@@ -67,6 +133,6 @@ namespace CoutUtils {
 
     template<typename T>
     void print(const std::string & name, const T & value) {
-        std::cout << name << ":[" << value << "]" << std::endl;
+        LOG(debug, name << ":[" << value << "]");
     }
 };
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "CoordinateUtils.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GridUtils {
+    // Evenly spaced cells of a grid without copying them: a row (step 1) or a column (step = row stride).
+    template<typename T>
+    class StridedView {
+    public:
+        // Counts cells instead of moving a pointer, so the end of a column never points past the grid.
+        class Iterator {
+        private:
+            T * first = nullptr;
+            std::ptrdiff_t step = 1;
+            size_t index = 0;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_const_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T *;
+            using reference = T &;
+
+            Iterator() {}
+            Iterator(T * first, std::ptrdiff_t step, size_t index) : first(first), step(step), index(index) {}
+
+            T & operator*() const {
+                return first[static_cast<std::ptrdiff_t>(index) * step];
+            }
+
+            T * operator->() const {
+                return &**this;
+            }
+
+            Iterator & operator++() {
+                index++;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator ret = *this;
+                index++;
+                return ret;
+            }
+
+            bool operator==(const Iterator & rhs) const {
+                return first == rhs.first && index == rhs.index;
+            }
+
+            bool operator!=(const Iterator & rhs) const {
+                return !(*this == rhs);
+            }
+        };
+
+    private:
+        T * first;
+        size_t count;
+        std::ptrdiff_t step;
+
+    public:
+        StridedView(T * first, size_t count, std::ptrdiff_t step) : first(first), count(count), step(step) {}
+
+        size_t size() const {
+            return count;
+        }
+
+        T & operator[](size_t i) const {
+            assert(i < count);
+            return first[static_cast<std::ptrdiff_t>(i) * step];
+        }
+
+        Iterator begin() const {
+            return Iterator(first, step, 0);
+        }
+
+        Iterator end() const {
+            return Iterator(first, step, count);
+        }
+    };
+
+    // Row-major grid in one contiguous allocation, indexed as grid[{x, y}] or grid.at(x, y).
+    // An optional border of 'padding' cells around it may be read and written like the grid itself
+    //  (x and y from -padding up to width/height + padding - 1), so neighbour lookups need no bounds checks.
+    template<typename T>
+    class Grid {
+        static_assert(!std::is_same_v<T, bool>, "std::vector<bool> has no addressable cells, use Grid<char>");
+
+    private:
+        size_t width = 0;
+        size_t height = 0;
+        size_t padding = 0;
+        size_t stride = 0;      //width + both borders
+        std::vector<T> cells;
+
+        size_t getIndex(std::ptrdiff_t x, std::ptrdiff_t y) const {
+            assert(x >= -static_cast<std::ptrdiff_t>(padding) && x < static_cast<std::ptrdiff_t>(width + padding));
+            assert(y >= -static_cast<std::ptrdiff_t>(padding) && y < static_cast<std::ptrdiff_t>(height + padding));
+            return (y + padding) * stride + (x + padding);
+        }
+
+    public:
+        Grid() {}
+        Grid(size_t width, size_t height) : Grid(width, height, T()) {}
+        Grid(size_t width, size_t height, const T & value, size_t padding = 0) : Grid(width, height, value, padding, value) {}
+        Grid(size_t width, size_t height, const T & value, size_t padding, const T & border) :
+            width(width),
+            height(height),
+            padding(padding),
+            stride(width + 2 * padding),
+            cells(stride * (height + 2 * padding), border)
+        {
+            fill(value);
+        }
+
+        size_t getWidth() const {
+            return width;
+        }
+
+        size_t getHeight() const {
+            return height;
+        }
+
+        size_t getPadding() const {
+            return padding;
+        }
+
+        bool empty() const {
+            return width == 0 || height == 0;
+        }
+
+        // Inside the grid proper, the border doesn't count.
+        template<typename I>
+        bool inBounds(const TCoordinates<I> & coordinates) const {
+            return coordinates.x >= 0 && static_cast<size_t>(coordinates.x) < width &&
+                   coordinates.y >= 0 && static_cast<size_t>(coordinates.y) < height;
+        }
+
+        template<typename I>
+        T & operator[](const TCoordinates<I> & coordinates) {
+            return cells[getIndex(coordinates.x, coordinates.y)];
+        }
+
+        template<typename I>
+        const T & operator[](const TCoordinates<I> & coordinates) const {
+            return cells[getIndex(coordinates.x, coordinates.y)];
+        }
+
+        T & at(std::ptrdiff_t x, std::ptrdiff_t y) {
+            return cells[getIndex(x, y)];
+        }
+
+        const T & at(std::ptrdiff_t x, std::ptrdiff_t y) const {
+            return cells[getIndex(x, y)];
+        }
+
+        StridedView<T> row(std::ptrdiff_t y) {
+            return StridedView<T>(cells.data() + (y + padding) * stride + padding, width, 1);
+        }
+
+        StridedView<const T> row(std::ptrdiff_t y) const {
+            return StridedView<const T>(cells.data() + (y + padding) * stride + padding, width, 1);
+        }
+
+        StridedView<T> column(std::ptrdiff_t x) {
+            return StridedView<T>(cells.data() + padding * stride + (x + padding), height, stride);
+        }
+
+        StridedView<const T> column(std::ptrdiff_t x) const {
+            return StridedView<const T>(cells.data() + padding * stride + (x + padding), height, stride);
+        }
+
+        // Sets every cell of the grid proper, the border keeps its value.
+        void fill(const T & value) {
+            for (size_t y=0; y < height; y++) {
+                for (auto & cell : row(y)) {
+                    cell = value;
+                }
+            }
+        }
+
+        // A transposed copy, border included.
+        Grid<T> transposed() const {
+            Grid<T> ret = *this;
+            std::swap(ret.width, ret.height);
+            ret.stride = height + 2 * padding;
+            const std::ptrdiff_t border = padding;
+            for (std::ptrdiff_t y = -border; y < static_cast<std::ptrdiff_t>(height) + border; y++) {
+                for (std::ptrdiff_t x = -border; x < static_cast<std::ptrdiff_t>(width) + border; x++) {
+                    ret.at(y, x) = at(x, y);
+                }
+            }
+            return ret;
+        }
+
+        bool operator==(const Grid<T> & rhs) const {
+            return width == rhs.width && height == rhs.height && padding == rhs.padding && cells == rhs.cells;
+        }
+
+        bool operator!=(const Grid<T> & rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
+    // The same cells seen with x and y swapped; rows of the view are columns of the grid.
+    template<typename T>
+    class TransposedView {
+    private:
+        Grid<T> & grid;
+
+    public:
+        TransposedView(Grid<T> & grid) : grid(grid) {}
+
+        size_t getWidth() const {
+            return grid.getHeight();
+        }
+
+        size_t getHeight() const {
+            return grid.getWidth();
+        }
+
+        template<typename I>
+        T & operator[](const TCoordinates<I> & coordinates) const {
+            return grid.at(coordinates.y, coordinates.x);
+        }
+
+        T & at(std::ptrdiff_t x, std::ptrdiff_t y) const {
+            return grid.at(y, x);
+        }
+
+        StridedView<T> row(std::ptrdiff_t y) const {
+            return grid.column(y);
+        }
+
+        StridedView<T> column(std::ptrdiff_t x) const {
+            return grid.row(x);
+        }
+    };
+
+    template<typename T>
+    TransposedView<T> transpose(Grid<T> & grid) {
+        return TransposedView<T>(grid);
+    }
+};
+
+template<typename T>
+using Grid = GridUtils::Grid<T>;
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace InputUtils {
+    // Read-only memory mapping of an input file. The mapping lives as long as this object,
+    //  so every std::string_view handed out from it is only valid for that lifetime.
+    class MappedFile {
+    private:
+        const char * data = nullptr;
+        size_t size = 0;
+        bool open = false;
+
+    public:
+        MappedFile(const std::filesystem::path & path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile & operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile && rhs) noexcept;
+        MappedFile & operator=(MappedFile && rhs) noexcept;
+
+        bool is_open() const {
+            return open;
+        }
+
+        std::string_view getContents() const {
+            return std::string_view(data, size);
+        }
+    };
+
+    // Hands out the lines of a buffer without copying them; behaves like std::getline on an istream
+    //  (the '\n' is stripped, a trailing line without '\n' is still returned).
+    class LineReader {
+    private:
+        std::string_view contents;
+        size_t position = 0;
+
+    public:
+        LineReader(std::string_view contents) : contents(contents) {}
+        LineReader(const MappedFile & file) : contents(file.getContents()) {}
+
+        bool getline(std::string_view & line);
+
+        std::vector<std::string_view> getLines();
+
+        void rewind() {
+            position = 0;
+        }
+
+        std::string_view getContents() const {
+            return contents;
+        }
+    };
+
+    inline bool getline(LineReader & reader, std::string_view & line) {
+        return reader.getline(line);
+    }
+};
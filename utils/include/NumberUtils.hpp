@@ -1,6 +1,16 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace NumberUtils {
     template <typename T, typename T2>
@@ -30,4 +40,133 @@ namespace NumberUtils {
 
         return true;
     }
+
+    inline bool isDigit(const char & c) {
+        return static_cast<unsigned char>(c - '0') < 10;
+    }
+
+    // Index of the first digit at or after index; inputString.size() if there is none.
+    inline size_t findDigit(std::string_view inputString, size_t index) {
+        const char * data = inputString.data();
+        const size_t size = inputString.size();
+#if defined(__AVX2__)
+        const __m256i zeroCharacters = _mm256_set1_epi8('0');
+        const __m256i nines = _mm256_set1_epi8(9);
+        for (; index + 32 <= size; index += 32) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + index));
+            const __m256i values = _mm256_sub_epi8(block, zeroCharacters);
+            // (unsigned) value <= 9  <=>  min(value, 9) == value
+            const __m256i digits = _mm256_cmpeq_epi8(_mm256_min_epu8(values, nines), values);
+            const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(digits));
+            if (mask != 0) {
+                return index + __builtin_ctz(mask);
+            }
+        }
+#endif
+#if defined(__SSE2__)
+        const __m128i zeroCharacters128 = _mm_set1_epi8('0');
+        const __m128i nines128 = _mm_set1_epi8(9);
+        for (; index + 16 <= size; index += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + index));
+            const __m128i values = _mm_sub_epi8(block, zeroCharacters128);
+            const __m128i digits = _mm_cmpeq_epi8(_mm_min_epu8(values, nines128), values);
+            const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(digits));
+            if (mask != 0) {
+                return index + __builtin_ctz(mask);
+            }
+        }
+#endif
+        // scalar fallback, and the tail that doesn't fill a whole register
+        for (; index < size; index++) {
+            if (isDigit(data[index])) {
+                return index;
+            }
+        }
+        return size;
+    }
+
+    // Parses every integer in inputString into out; anything that is not a digit separates numbers
+    //  and a '-' directly in front of a number makes it negative.
+    // Writes at most capacity numbers and returns how many were written.
+    template <typename T>
+    size_t parseNumbers(std::string_view inputString, T * out, size_t capacity) {
+        const char * data = inputString.data();
+        const size_t size = inputString.size();
+        size_t count = 0;
+        size_t i = findDigit(inputString, 0);
+        while (i < size && count < capacity) {
+            const bool negative = (i > 0 && data[i-1] == '-');
+            T value = 0;
+            for (; i < size && isDigit(data[i]); i++) {
+                value = value * 10 + (data[i] - '0');
+            }
+            out[count++] = negative ? -value : value;
+            i = findDigit(inputString, i);
+        }
+        return count;
+    }
+
+    // Appends every integer in inputString to out.
+    template <typename T>
+    size_t parseNumbers(std::string_view inputString, std::vector<T> & out) {
+        const size_t previousSize = out.size();
+        out.resize(previousSize + (inputString.size() + 1) / 2);    //upper bound: single digits with single separators
+        const size_t count = parseNumbers(inputString, out.data() + previousSize, out.size() - previousSize);
+        out.resize(previousSize + count);
+        return count;
+    }
+
+    // x = remainder (mod modulus), with 0 <= remainder < modulus
+    template <typename T>
+    struct Congruence {
+        T remainder;
+        T modulus;
+    };
+
+    __extension__ typedef __int128 int128Type;
+    __extension__ typedef unsigned __int128 uint128Type;
+
+    // x with a * x = 1 (mod modulus), for a and modulus coprime.
+    inline int128Type modularInverse(int128Type a, int128Type modulus) {
+        int128Type oldR = a % modulus, r = modulus;
+        int128Type oldS = 1, s = 0;
+        while (r != 0) {
+            const int128Type quotient = oldR / r;
+            oldR -= quotient * r;
+            std::swap(oldR, r);
+            oldS -= quotient * s;
+            std::swap(oldS, s);
+        }
+        return ((oldS % modulus) + modulus) % modulus;
+    }
+
+    enum combine_e {
+        e_combined,         // out holds the combined congruence
+        e_contradiction,    // no x satisfies both
+        e_overflow          // there are solutions, but their modulus doesn't fit in T
+    };
+
+    // The generalized Chinese Remainder Theorem: the x that satisfies both congruences, modulo the lcm of both moduli.
+    // The moduli don't have to be coprime. Intermediate products are 128 bit, so the lcm may use the full range of T.
+    template <typename T>
+    combine_e combineCongruences(const Congruence<T> & lhs, const Congruence<T> & rhs, Congruence<T> & out) {
+        const int128Type g = std::gcd(lhs.modulus, rhs.modulus);
+        const int128Type difference = static_cast<int128Type>(rhs.remainder) - lhs.remainder;
+        if (difference % g != 0) {
+            return e_contradiction;
+        }
+        const int128Type lhsModulus = lhs.modulus / g;
+        const int128Type rhsModulus = rhs.modulus / g;
+        int128Type k = ((difference / g) % rhsModulus) * modularInverse(lhsModulus, rhsModulus) % rhsModulus;
+        if (k < 0) {
+            k += rhsModulus;
+        }
+        const int128Type modulus = lhsModulus * rhs.modulus;
+        if (modulus > static_cast<int128Type>(std::numeric_limits<T>::max())) {
+            return e_overflow;
+        }
+        const int128Type remainder = (lhs.remainder + lhs.modulus * k) % modulus;
+        out = Congruence<T>{static_cast<T>(remainder), static_cast<T>(modulus)};
+        return e_combined;
+    }
 };
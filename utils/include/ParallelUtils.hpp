@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Spreads independent per-line work over all cores.
+// The indices [0, count) are cut into chunks of 'grain' indices; idle threads keep taking the next chunk,
+//  so cheap and expensive lines balance out. The chunks don't depend on the number of threads
+//  and their results are combined in chunk order, so every run gives the same result.
+namespace ParallelUtils {
+    constexpr size_t DEFAULT_GRAIN = 64;
+
+    // Worker threads that live as long as the process, one less than the hardware offers (or than $AOC_THREADS asks for):
+    //  the calling thread works too.
+    class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+        std::mutex runMutex;        //one job at a time
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        const std::function<void(size_t)> * job = nullptr;
+        size_t chunkCount = 0;
+        std::atomic<size_t> nextChunk = 0;
+        size_t busyWorkers = 0;
+        unsigned long int generation = 0;
+        bool stopping = false;
+
+        void workerLoop();
+        void work();
+
+    public:
+        ThreadPool(size_t workerCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool & operator=(const ThreadPool &) = delete;
+
+        size_t getThreadCount() const {
+            return workers.size() + 1;
+        }
+
+        // Calls chunk(c) for every c in [0, chunkCount) and returns once all of them are done.
+        // Called from inside a chunk, it just runs on the calling thread.
+        void run(size_t chunkCount, const std::function<void(size_t)> & chunk);
+    };
+
+    ThreadPool & getThreadPool();
+
+    // Sum of function(i) for i in [0, count), starting from init.
+    template<typename T, typename F>
+    T parallelReduce(size_t count, T init, F function, size_t grain = DEFAULT_GRAIN) {
+        const size_t chunkCount = (count + grain - 1) / grain;
+        std::vector<T> partialSums(chunkCount, T());
+        getThreadPool().run(chunkCount, [&](size_t chunk) {
+            T & partialSum = partialSums[chunk];
+            for (size_t i = chunk * grain; i < std::min(count, (chunk + 1) * grain); i++) {
+                partialSum += function(i);
+            }
+        });
+
+        for (const auto & partialSum : partialSums) {
+            init += partialSum;
+        }
+        return init;
+    }
+
+    // { function(0), function(1), ... function(count-1) }, e.g. to parse every line into an object.
+    template<typename F>
+    auto parallelTransform(size_t count, F function, size_t grain = DEFAULT_GRAIN) {
+        using resultType = std::decay_t<decltype(function(size_t()))>;
+        const size_t chunkCount = (count + grain - 1) / grain;
+        std::vector<std::vector<resultType>> chunkResults(chunkCount);
+        getThreadPool().run(chunkCount, [&](size_t chunk) {
+            auto & results = chunkResults[chunk];
+            const size_t end = std::min(count, (chunk + 1) * grain);
+            results.reserve(end - chunk * grain);
+            for (size_t i = chunk * grain; i < end; i++) {
+                results.push_back(function(i));
+            }
+        });
+
+        std::vector<resultType> ret;
+        ret.reserve(count);
+        for (auto & results : chunkResults) {
+            std::move(results.begin(), results.end(), std::back_inserter(ret));
+        }
+        return ret;
+    }
+};
@@ -1,7 +1,14 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace RangeUtils {
     template<typename T>
@@ -101,5 +108,203 @@ namespace RangeUtils {
         return rhs.inRange(lhs.getStart()) && rhs.inRange(lhs.getEnd());
     }
 
+    // A set of values kept as sorted, disjoint ranges; ranges that overlap or touch are merged into one.
+    // The set operations below walk both sets side by side, so they are O(n + m) in the number of ranges.
+    template<typename T>
+    class RangeSet {
+        static_assert(std::is_integral_v<T>, "touching ranges are only well defined for integers");
+
+    private:
+        std::vector<Range<T>> ranges;
+
+        // Whether 'next', which doesn't start before 'previous', overlaps or touches it.
+        static bool joins(const Range<T> & previous, const Range<T> & next) {
+            return previous.getEnd() == std::numeric_limits<T>::max() || next.getStart() <= previous.getEnd() + 1;
+        }
+
+    public:
+        RangeSet() {}
+        RangeSet(std::initializer_list<Range<T>> ranges) : RangeSet(std::vector<Range<T>>(ranges)) {}
+
+        // Any ranges, in any order; empty ones are dropped.
+        explicit RangeSet(std::vector<Range<T>> unsortedRanges) {
+            std::sort(unsortedRanges.begin(), unsortedRanges.end(), [](const Range<T> & lhs, const Range<T> & rhs) {
+                return lhs.getStart() < rhs.getStart();
+            });
+            for (const auto & range : unsortedRanges) {
+                append(range);
+            }
+        }
+
+        // Adds a range that doesn't start before any range already in the set.
+        void append(const Range<T> & range) {
+            if (range.empty()) {
+                return;
+            }
+            assert(ranges.empty() || range.getStart() >= ranges.back().getStart());
+            if (!ranges.empty() && joins(ranges.back(), range)) {
+                ranges.back() = Range<T>(ranges.back().getStart(), std::max(ranges.back().getEnd(), range.getEnd()));
+            } else {
+                ranges.push_back(range);
+            }
+        }
+
+        bool empty() const {
+            return ranges.empty();
+        }
+
+        // The number of ranges, not of values.
+        size_t size() const {
+            return ranges.size();
+        }
+
+        const std::vector<Range<T>> & getRanges() const {
+            return ranges;
+        }
+
+        // The range holding the lowest values.
+        const Range<T> & front() const {
+            assert(!ranges.empty());
+            return ranges.front();
+        }
+
+        typename std::vector<Range<T>>::const_iterator begin() const {
+            return ranges.begin();
+        }
+
+        typename std::vector<Range<T>>::const_iterator end() const {
+            return ranges.end();
+        }
+
+        bool contains(const T & value) const {
+            auto range = std::upper_bound(ranges.begin(), ranges.end(), value, [](const T & value, const Range<T> & range) {
+                return value < range.getStart();
+            });
+            return range != ranges.begin() && std::prev(range)->inRange(value);
+        }
+
+        std::string toString() const {
+            std::string ret = "{";
+            for (const auto & range : ranges) {
+                ret += range.toString();
+            }
+            return ret + "}";
+        }
+
+        bool operator==(const RangeSet<T> & rhs) const {
+            return ranges.size() == rhs.ranges.size() && std::equal(ranges.begin(), ranges.end(), rhs.ranges.begin(), [](const Range<T> & lhs, const Range<T> & rhs) {
+                return lhs.getStart() == rhs.getStart() && lhs.getEnd() == rhs.getEnd();
+            });
+        }
+
+        bool operator!=(const RangeSet<T> & rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
+    template<typename T>
+    RangeSet<T> unite(const RangeSet<T> & lhs, const RangeSet<T> & rhs) {
+        RangeSet<T> ret;
+        auto lhsRange = lhs.begin();
+        auto rhsRange = rhs.begin();
+        while (lhsRange != lhs.end() || rhsRange != rhs.end()) {
+            if (rhsRange == rhs.end() || (lhsRange != lhs.end() && lhsRange->getStart() < rhsRange->getStart())) {
+                ret.append(*lhsRange++);
+            } else {
+                ret.append(*rhsRange++);
+            }
+        }
+        return ret;
+    }
+
+    template<typename T>
+    RangeSet<T> intersect(const RangeSet<T> & lhs, const RangeSet<T> & rhs) {
+        RangeSet<T> ret;
+        auto lhsRange = lhs.begin();
+        auto rhsRange = rhs.begin();
+        while (lhsRange != lhs.end() && rhsRange != rhs.end()) {
+            ret.append(intersect(*lhsRange, *rhsRange));
+            // the range that ends first can't overlap anything further on
+            if (lhsRange->getEnd() < rhsRange->getEnd()) {
+                lhsRange++;
+            } else {
+                rhsRange++;
+            }
+        }
+        return ret;
+    }
+
+    // The values of lhs that are not in rhs.
+    template<typename T>
+    RangeSet<T> difference(const RangeSet<T> & lhs, const RangeSet<T> & rhs) {
+        RangeSet<T> ret;
+        auto rhsRange = rhs.begin();
+        for (const auto & range : lhs) {
+            while (rhsRange != rhs.end() && rhsRange->getEnd() < range.getStart()) {
+                rhsRange++;
+            }
+            // cut out every range of rhs that overlaps; the last one may still overlap the next range of lhs
+            T start = range.getStart();
+            bool removedUpToEnd = false;
+            for (auto cut = rhsRange; cut != rhs.end() && cut->getStart() <= range.getEnd(); cut++) {
+                if (cut->getStart() > start) {
+                    ret.append(Range<T>(start, cut->getStart() - 1));
+                }
+                if (cut->getEnd() >= range.getEnd()) {
+                    removedUpToEnd = true;
+                    break;
+                }
+                start = cut->getEnd() + 1;
+                rhsRange = cut;
+            }
+            if (!removedUpToEnd) {
+                ret.append(Range<T>(start, range.getEnd()));
+            }
+        }
+        return ret;
+    }
+
+    template<typename T>
+    RangeSet<T> shift(const RangeSet<T> & lhs, const T & rhs) {
+        RangeSet<T> ret;
+        for (const auto & range : lhs) {
+            ret.append(shift(range, rhs));
+        }
+        return ret;
+    }
+
+    // From 'start' up to the start of the next breakpoint (in a list sorted on start), values move by 'offset'.
+    template<typename T>
+    struct Breakpoint {
+        T start;
+        T offset;
+    };
+
+    // Moves every value of lhs by the offset of the piece it lies in; values before the first breakpoint stay where they are.
+    // One sweep over both lists splits the ranges; as the pieces may land in any order, they are sorted back into a set.
+    template<typename T>
+    RangeSet<T> applyOffsets(const RangeSet<T> & lhs, const std::vector<Breakpoint<T>> & breakpoints) {
+        std::vector<Range<T>> pieces;
+        pieces.reserve(lhs.size());
+        auto nextBreakpoint = breakpoints.begin();
+        T offset = 0;
+        for (const auto & range : lhs) {
+            T start = range.getStart();
+            while (true) {
+                while (nextBreakpoint != breakpoints.end() && nextBreakpoint->start <= start) {
+                    offset = nextBreakpoint->offset;
+                    nextBreakpoint++;
+                }
+                if (nextBreakpoint == breakpoints.end() || nextBreakpoint->start > range.getEnd()) {
+                    pieces.push_back(shift(Range<T>(start, range.getEnd()), offset));
+                    break;
+                }
+                pieces.push_back(shift(Range<T>(start, nextBreakpoint->start - 1), offset));
+                start = nextBreakpoint->start;
+            }
+        }
+        return RangeSet<T>(std::move(pieces));
+    }
+
 
 };
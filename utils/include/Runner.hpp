@@ -0,0 +1,54 @@
+#pragma once
+
+#include "InputUtils.hpp"
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Glue between the days and the 'aoc' driver (runner/main.cpp).
+// Every day registers its solvers when compiled with AOC_RUNNER; on its own it keeps its own main().
+namespace Runner {
+    using Clock = std::chrono::steady_clock;
+    using solutionType = long long int;
+    using solveFunction = std::function<solutionType(InputUtils::LineReader &)>;
+
+    inline std::optional<Clock::time_point> & getParsedTimePoint() {
+        static std::optional<Clock::time_point> parsedTimePoint;
+        return parsedTimePoint;
+    }
+
+    // Called by a solver once its input is parsed, so the driver can split parse time from solve time.
+    inline void markParsed() {
+        getParsedTimePoint() = Clock::now();
+    }
+
+    struct Puzzle {
+        int day;
+        solveFunction solve[2];
+        std::string_view givenTestData[2];
+        std::optional<solutionType> expectedSolution[2];
+    };
+
+    inline std::vector<Puzzle> & getPuzzles() {
+        static std::vector<Puzzle> puzzles;
+        return puzzles;
+    }
+
+    class Registration {
+    public:
+        template<typename Solve1, typename Solve2>
+        Registration(int day, Solve1 solve1, Solve2 solve2,
+                     std::string_view givenTestData_problem1 = {}, std::optional<solutionType> expectedSolution_problem1 = {},
+                     std::string_view givenTestData_problem2 = {}, std::optional<solutionType> expectedSolution_problem2 = {}) {
+            getPuzzles().push_back(Puzzle{
+                day,
+                {solve1, solve2},
+                {givenTestData_problem1, givenTestData_problem2},
+                {expectedSolution_problem1, expectedSolution_problem2}
+            });
+        }
+    };
+};
@@ -1,11 +1,126 @@
 #pragma once
 
+#include <cassert>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace StringUtils {
-    std::vector<std::string> split(const std::string & inputString, const std::string & delimiter, bool includeDelimiter = false);
-    std::string remove(const std::string & inputString, const std::string & toBeRemovedString);
-    bool contains(const std::string & inputString, const std::string & checkIfThisIsInInputString);
-    std::string replaceAllCharacters(const std::string & inputString, const char & characterToReplace, const char & characterToReplaceWith);
+    // Lazy range over the tokens of inputString between occurrences of delimiter.
+    // Tokens are views into inputString (no copies); empty tokens are kept, just like split().
+    class SplitView {
+    public:
+        class Iterator {
+        private:
+            std::string_view inputString;
+            std::string_view delimiter;
+            size_t tokenStart = std::string_view::npos;     //npos marks the end
+            size_t tokenEnd = std::string_view::npos;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view *;
+            using reference = std::string_view;
+
+            Iterator() {}
+            Iterator(std::string_view inputString, std::string_view delimiter) :
+                inputString(inputString),
+                delimiter(delimiter),
+                tokenStart(0)
+            {
+                findTokenEnd();
+            }
+
+            std::string_view operator*() const {
+                return inputString.substr(tokenStart, tokenEnd - tokenStart);
+            }
+
+            Iterator & operator++() {
+                if (tokenEnd == inputString.size()) {
+                    tokenStart = std::string_view::npos;
+                } else {
+                    tokenStart = tokenEnd + delimiter.size();
+                    findTokenEnd();
+                }
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            bool operator==(const Iterator & rhs) const {
+                return tokenStart == rhs.tokenStart;
+            }
+
+            bool operator!=(const Iterator & rhs) const {
+                return tokenStart != rhs.tokenStart;
+            }
+
+        private:
+            void findTokenEnd() {
+                tokenEnd = inputString.find(delimiter, tokenStart);
+                if (tokenEnd == std::string_view::npos) {
+                    tokenEnd = inputString.size();
+                }
+            }
+        };
+
+    private:
+        std::string_view inputString;
+        std::string_view delimiter;
+
+    public:
+        SplitView(std::string_view inputString, std::string_view delimiter) :
+            inputString(inputString),
+            delimiter(delimiter)
+        {
+            assert(!delimiter.empty());
+        }
+
+        Iterator begin() const {
+            return Iterator(inputString, delimiter);
+        }
+
+        Iterator end() const {
+            return Iterator();
+        }
+    };
+
+    inline SplitView splitView(std::string_view inputString, std::string_view delimiter) {
+        return SplitView(inputString, delimiter);
+    }
+
+    // Returns inputString without the leading prefix; the prefix has to be there.
+    inline std::string_view removePrefix(std::string_view inputString, std::string_view prefix) {
+        assert(inputString.substr(0, prefix.size()) == prefix);
+        return inputString.substr(prefix.size());
+    }
+
+    // Like std::stoi/std::stoll: skips leading whitespace and ignores whatever follows the number.
+    template<typename T>
+    T toNumber(std::string_view inputString) {
+        size_t i = 0;
+        while (i < inputString.size() && std::isspace(static_cast<unsigned char>(inputString[i]))) {
+            i++;
+        }
+        T ret = 0;
+        [[maybe_unused]] auto result = std::from_chars(inputString.data() + i, inputString.data() + inputString.size(), ret);
+        assert(result.ec == std::errc());
+        return ret;
+    }
+
+    // includeDelimiter keeps the delimiter at the end of every token that was followed by one.
+    std::vector<std::string> split(std::string_view inputString, std::string_view delimiter, bool includeDelimiter = false);
+    std::string remove(std::string_view inputString, std::string_view toBeRemovedString);
+    bool contains(std::string_view inputString, std::string_view checkIfThisIsInInputString);
+    std::string replaceAllCharacters(std::string_view inputString, const char & characterToReplace, const char & characterToReplaceWith);
 };
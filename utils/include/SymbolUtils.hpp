@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace SymbolUtils {
+    using idType = unsigned int;
+
+    // Interns names as dense IDs (0, 1, 2, ... in the order they are first seen),
+    //  so they can index a vector instead of being copied and hashed over and over.
+    class SymbolTable {
+    private:
+        std::deque<std::string> names;      //a deque never moves its elements, so the views in 'ids' stay valid
+        std::unordered_map<std::string_view, idType> ids;
+
+    public:
+        // The ID of name, a new one if it wasn't seen before.
+        idType intern(std::string_view name) {
+            auto id = ids.find(name);
+            if (id != ids.end()) {
+                return id->second;
+            }
+            const idType newId = names.size();
+            names.emplace_back(name);
+            ids.emplace(names.back(), newId);
+            return newId;
+        }
+
+        std::optional<idType> find(std::string_view name) const {
+            auto id = ids.find(name);
+            if (id == ids.end()) {
+                return std::nullopt;
+            }
+            return id->second;
+        }
+
+        const std::string & getName(idType id) const {
+            assert(id < names.size());
+            return names[id];
+        }
+
+        size_t size() const {
+            return names.size();
+        }
+    };
+};
@@ -1,25 +1,32 @@
 #pragma once
 
-#include <vector>
+#include "Grid.hpp"
+
+#include <algorithm>
 #include <queue>
+#include <string_view>
+#include <vector>
 
 namespace VectorUtils {
 
-    bool convertToMap(const std::vector<std::string> & lines, std::vector<std::vector<char> > & map) {
+    // Lines shorter than the first one are filled up with 'border' as well.
+    inline bool convertToMap(const std::vector<std::string_view> & lines, Grid<char> & map, size_t padding = 0, char border = '.') {
         if (lines.empty()) {
+            map = Grid<char>();
             return true;
         }
         bool equalLines = true;
-        const std::string & firstLine = lines[0];
-        for (const std::string & line : lines) {
-            std::vector<char> mapLine;
+        std::string_view firstLine = lines[0];
+        map = Grid<char>(firstLine.size(), lines.size(), border, padding, border);
+        for (size_t y=0; y < lines.size(); y++) {
+            std::string_view line = lines[y];
             if (line.size() != firstLine.size()) {
                 equalLines = false;
             }
-            for (const char & c : line) {
-                mapLine.push_back(c);
+            auto mapRow = map.row(y);
+            for (size_t x=0; x < line.size() && x < mapRow.size(); x++) {
+                mapRow[x] = line[x];
             }
-            map.push_back(mapLine);
         }
 
         return equalLines;
@@ -0,0 +1,90 @@
+#include "InputUtils.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utility>
+
+InputUtils::MappedFile::MappedFile(const std::filesystem::path & path) {
+    int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        return;
+    }
+
+    struct stat fileStatus;
+    if (::fstat(fileDescriptor, &fileStatus) != 0) {
+        ::close(fileDescriptor);
+        return;
+    }
+
+    size = static_cast<size_t>(fileStatus.st_size);
+    if (size == 0) {
+        // mmap refuses zero-length mappings; an empty file is still a valid (empty) input.
+        ::close(fileDescriptor);
+        open = true;
+        return;
+    }
+
+    void * mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    ::close(fileDescriptor);    //the mapping keeps its own reference to the file
+    if (mapping == MAP_FAILED) {
+        size = 0;
+        return;
+    }
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    data = static_cast<const char *>(mapping);
+    open = true;
+}
+
+InputUtils::MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        ::munmap(const_cast<char *>(data), size);
+    }
+}
+
+InputUtils::MappedFile::MappedFile(MappedFile && rhs) noexcept :
+    data(std::exchange(rhs.data, nullptr)),
+    size(std::exchange(rhs.size, 0)),
+    open(std::exchange(rhs.open, false))
+{
+}
+
+InputUtils::MappedFile & InputUtils::MappedFile::operator=(MappedFile && rhs) noexcept {
+    if (this != &rhs) {
+        if (data != nullptr) {
+            ::munmap(const_cast<char *>(data), size);
+        }
+        data = std::exchange(rhs.data, nullptr);
+        size = std::exchange(rhs.size, 0);
+        open = std::exchange(rhs.open, false);
+    }
+    return *this;
+}
+
+bool InputUtils::LineReader::getline(std::string_view & line) {
+    if (position >= contents.size()) {
+        return false;
+    }
+
+    auto i = contents.find('\n', position);
+    if (i == std::string_view::npos) {
+        // last line without a trailing newline
+        line = contents.substr(position);
+        position = contents.size();
+    } else {
+        line = contents.substr(position, i - position);
+        position = i + 1;
+    }
+    return true;
+}
+
+std::vector<std::string_view> InputUtils::LineReader::getLines() {
+    std::vector<std::string_view> ret;
+    for (std::string_view line; getline(line);) {
+        ret.push_back(line);
+    }
+    return ret;
+}
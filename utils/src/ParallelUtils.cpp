@@ -0,0 +1,91 @@
+#include "ParallelUtils.hpp"
+
+#include <cstdlib>
+#include <string>
+
+namespace {
+    // Set while a thread runs chunks, so a nested run() doesn't wait for workers that are busy with its own job.
+    thread_local bool insideJob = false;
+};
+
+ParallelUtils::ThreadPool::ThreadPool(size_t workerCount) {
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ParallelUtils::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto & worker : workers) {
+        worker.join();
+    }
+}
+
+void ParallelUtils::ThreadPool::run(size_t chunkCount, const std::function<void(size_t)> & chunk) {
+    if (chunkCount <= 1 || workers.empty() || insideJob) {
+        for (size_t c = 0; c < chunkCount; c++) {
+            chunk(c);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(runMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &chunk;
+        this->chunkCount = chunkCount;
+        nextChunk = 0;
+        busyWorkers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    work();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void ParallelUtils::ThreadPool::workerLoop() {
+    unsigned long int finishedGeneration = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this, &finishedGeneration]() { return stopping || generation != finishedGeneration; });
+        if (stopping) {
+            return;
+        }
+        finishedGeneration = generation;
+
+        lock.unlock();
+        work();
+        lock.lock();
+
+        if (--busyWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ParallelUtils::ThreadPool::work() {
+    insideJob = true;
+    for (size_t c = nextChunk++; c < chunkCount; c = nextChunk++) {
+        (*job)(c);
+    }
+    insideJob = false;
+}
+
+ParallelUtils::ThreadPool & ParallelUtils::getThreadPool() {
+    static ThreadPool threadPool([]() -> size_t {
+        size_t threadCount = std::thread::hardware_concurrency();
+        if (const char * threads = std::getenv("AOC_THREADS")) {
+            threadCount = std::stoul(threads);
+        }
+        return std::max<size_t>(threadCount, 1) - 1;
+    }());
+    return threadPool;
+}
@@ -1,41 +1,34 @@
 #include "StringUtils.hpp"
 
-std::vector<std::string> StringUtils::split(const std::string & inputString, const std::string & delimiter, bool includeDelimiter) {
+std::vector<std::string> StringUtils::split(std::string_view inputString, std::string_view delimiter, bool includeDelimiter) {
     std::vector<std::string> ret;
-
-    auto i = inputString.find(delimiter);
-    if (i == std::string::npos) {
-        return {inputString};
-    } else {
-        std::string firstPart = inputString.substr(0, i);
-        ret.push_back(firstPart);
-    
-        std::string unprocessedPart = inputString.substr(i+delimiter.size());
-
-        auto otherParts = StringUtils::split(unprocessedPart, delimiter, includeDelimiter);
-        ret.insert(ret.end(), otherParts.begin(), otherParts.end());
+    for (std::string_view token : StringUtils::splitView(inputString, delimiter)) {
+        ret.emplace_back(token);
+    }
+    if (includeDelimiter) {     //every token but the last one was followed by the delimiter
+        for (size_t i=0; i + 1 < ret.size(); i++) {
+            ret[i] += delimiter;
+        }
     }
-
     return ret;
 }
 
 
-std::string StringUtils::remove(const std::string & inputString, const std::string & toBeRemovedString) {
+std::string StringUtils::remove(std::string_view inputString, std::string_view toBeRemovedString) {
     std::string ret;
-    auto stringFragments = StringUtils::split(inputString, toBeRemovedString, false);   //this removes the "delimiter"; so use that and just stick it back together afterwards.
-
-    for (auto stringFragment : stringFragments) {
+    ret.reserve(inputString.size());
+    for (std::string_view stringFragment : StringUtils::splitView(inputString, toBeRemovedString)) {   //this removes the "delimiter"; so use that and just stick it back together afterwards.
         ret += stringFragment;
     }
 
     return ret;
 }
 
-bool StringUtils::contains(const std::string & inputString, const std::string & checkIfThisIsInInputString) {
-    return (inputString.find(checkIfThisIsInInputString) != std::string::npos);
+bool StringUtils::contains(std::string_view inputString, std::string_view checkIfThisIsInInputString) {
+    return (inputString.find(checkIfThisIsInInputString) != std::string_view::npos);
 }
 
-std::string StringUtils::replaceAllCharacters(const std::string & inputString, const char & characterToReplace, const char & characterToReplaceWith) {
+std::string StringUtils::replaceAllCharacters(std::string_view inputString, const char & characterToReplace, const char & characterToReplaceWith) {
     std::string ret;
     for (const auto & c : inputString) {
         if (c == characterToReplace) {